@@ -29,10 +29,13 @@ GridLayout {
   anchors.leftMargin: 10
   anchors.rightMargin: 10
 
+  // Set by the plugin when the shader grid is configured
+  property bool shaderMode: false
+
   // Left spacer
   Item {
     Layout.columnSpan: 1
-    Layout.rowSpan: 15
+    Layout.rowSpan: 16
     Layout.fillWidth: true
   }
 
@@ -50,10 +53,21 @@ GridLayout {
   // Right spacer
   Item {
     Layout.columnSpan: 1
-    Layout.rowSpan: 15
+    Layout.rowSpan: 16
     Layout.fillWidth: true
   }
 
+  CheckBox {
+    Layout.alignment: Qt.AlignHCenter
+    id: shadergrid
+    Layout.columnSpan: 4
+    text: qsTr("Adaptive Shader Grid")
+    checked: shaderMode
+    onClicked: {
+      TesseractGridConfig.OnShaderMode(checked)
+    }
+  }
+
   Label {
     Layout.columnSpan: 4
     text: "Cell Count"
@@ -106,9 +120,9 @@ GridLayout {
     Layout.columnSpan: 2
     id: cellLength
     maximumValue: 1000.00
-    minimumValue: 0.01
+    minimumValue: 0.001
     value: 1.00
-    decimals: 2
+    decimals: 3
     stepSize: 0.01
     onEditingFinished: TesseractGridConfig.UpdateCellLength(cellLength.value)
   }
@@ -0,0 +1,121 @@
+/**
+ * @file grid_utils.h
+ * @brief Registry of the scene grid shared by the render utils and the grid config plugin
+ *
+ * @author Levi Armstrong
+ * @date October 18, 2026
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @copyright Copyright (c) 2020, Southwest Research Institute
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TESSERACT_IGNITION_GRID_UTILS_H
+#define TESSERACT_IGNITION_GRID_UTILS_H
+
+#include <memory>
+#include <string>
+#include <variant>
+
+#include <ignition/rendering/Grid.hh>
+#include <ignition/rendering/Scene.hh>
+#include <ignition/rendering/Visual.hh>
+
+namespace tesseract_ignition
+{
+
+/** @brief The name of the visual holding the grid, whoever creates the grid must use it and register the visual */
+static const std::string GRID_VISUAL_NAME = "tesseract_grid";
+
+/** @brief The name of the plane drawing the grid in shader mode, it is not part of the environment and is not picked */
+static const std::string GRID_SHADER_VISUAL_NAME = GRID_VISUAL_NAME + "_shader";
+
+/** @brief The user data of the scene root visual holding the id of the grid visual, this is the grid registry */
+static const std::string GRID_VISUAL_ID_KEY = "tesseract_grid_visual_id";
+
+/**
+ * @brief Register the visual holding the grid of a scene, whoever creates the grid must call this
+ *
+ * The id is kept in the user data of the root visual, so the render utils and the grid config plugin share it
+ * without linking to each other. Registering a new grid is how the others learn the grid was recreated.
+ *
+ * @param scene The scene of the grid
+ * @param visual The visual holding the grid
+ */
+inline void registerGrid(const ignition::rendering::ScenePtr& scene, const ignition::rendering::VisualPtr& visual)
+{
+  scene->RootVisual()->SetUserData(GRID_VISUAL_ID_KEY, static_cast<int>(visual->Id()));
+}
+
+/**
+ * @brief Get the id of the registered grid visual of a scene
+ *
+ * This only reads the user data of the root visual, so it is cheap enough to check every frame for a new grid.
+ *
+ * @param scene The scene to check
+ * @return The id of the grid visual, 0 if no grid was registered
+ */
+inline unsigned getGridVisualId(const ignition::rendering::ScenePtr& scene)
+{
+  ignition::rendering::Variant id = scene->RootVisual()->UserData(GRID_VISUAL_ID_KEY);
+  const int* value = std::get_if<int>(&id);
+  return (value != nullptr) ? static_cast<unsigned>(*value) : 0;
+}
+
+/**
+ * @brief Find the registered grid visual of a scene
+ *
+ * This looks the visual up in the scene, so only call it when getGridVisualId changes.
+ *
+ * @param scene The scene to search
+ * @return The grid visual, nullptr if no grid was registered or it has been destroyed
+ */
+inline ignition::rendering::VisualPtr findGridVisual(const ignition::rendering::ScenePtr& scene)
+{
+  unsigned id = getGridVisualId(scene);
+  if (id == 0)
+    return nullptr;
+
+  return scene->VisualById(id);
+}
+
+/**
+ * @brief Find the registered grid of a scene
+ *
+ * This looks the visual up in the scene, so only call it when getGridVisualId changes.
+ *
+ * @param scene The scene to search
+ * @return The grid, nullptr if no grid was registered or it has been destroyed
+ */
+inline ignition::rendering::GridPtr findGrid(const ignition::rendering::ScenePtr& scene)
+{
+  ignition::rendering::VisualPtr visual = findGridVisual(scene);
+  if (visual == nullptr)
+    return nullptr;
+
+  for (unsigned int i = 0; i < visual->GeometryCount(); ++i)
+  {
+    auto grid = std::dynamic_pointer_cast<ignition::rendering::Grid>(visual->GeometryByIndex(i));
+    if (grid != nullptr)
+      return grid;
+  }
+
+  return nullptr;
+}
+
+}
+
+#endif // TESSERACT_IGNITION_GRID_UTILS_H
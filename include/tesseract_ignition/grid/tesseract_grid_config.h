@@ -29,6 +29,15 @@ namespace plugins
 {
   class TesseractGridConfigPrivate;
 
+  /// \brief Configures the grid of the scene, creating one if there is none.
+  ///
+  /// ## Configuration
+  ///
+  /// * \<mode\> : Optional, "lines" (default) draws the grid as line
+  ///              geometry, "shader" draws a grid centred under the camera
+  ///              in a fragment shader, its line spacing starts at the cell
+  ///              length and grows by ten as the camera zooms out. The cell
+  ///              counts and rotation only apply to the line grid.
   class TesseractGridConfig : public ignition::gui::Plugin
   {
     Q_OBJECT
@@ -78,6 +87,11 @@ namespace plugins
     /// \param[in] _checked indicates show or hide grid
     public slots: void OnShow(bool _checked);
 
+    /// \brief Callback when the shader mode checkbox is clicked.
+    /// \param[in] _checked True to draw the adaptive shader grid, false for
+    /// the line grid
+    public slots: void OnShaderMode(bool _checked);
+
     /// \internal
     /// \brief Pointer to private data.
     private: std::unique_ptr<TesseractGridConfigPrivate> dataPtr;
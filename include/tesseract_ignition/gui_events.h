@@ -19,9 +19,20 @@
 #include <QEvent>
 #include <utility>
 #include <vector>
+#include <memory>
 #include <ignition/math/Vector3.hh>
 //#include "ignition/gazebo/Entity.hh"
 
+namespace tesseract_scene_graph
+{
+  class SceneGraph;
+}
+
+namespace tesseract_visualization
+{
+  class EntityManager;
+}
+
 namespace tesseract_ignition
 {
 namespace gui
@@ -82,42 +93,42 @@ namespace events
   };
 
   /// \brief Event that notifies when new entities have been selected.
-//  class EntitiesSelected : public QEvent
-//  {
-//    /// \brief Constructor
-//    /// \param[in] _entities All the selected entities
-//    /// \param[in] _fromUser True if the event was directly generated by the
-//    /// user, false in case it's been propagated through a different mechanism.
-//    public: explicit EntitiesSelected(
-//        const std::vector<Entity> &_entities,  // NOLINT
-//        bool _fromUser = false)
-//        : QEvent(kType), entities(_entities), fromUser(_fromUser)
-//    {
-//    }
-
-//    /// \brief Get the data sent with the event.
-//    /// \return The entities being selected.
-//    public: std::vector<Entity> Data() const
-//    {
-//      return this->entities;
-//    }
-
-//    /// \brief Get whether the event was generated by the user.
-//    /// \return True for the user.
-//    public: bool FromUser() const
-//    {
-//      return this->fromUser;
-//    }
-
-//    /// \brief Unique type for this event.
-//    static const QEvent::Type kType = QEvent::Type(QEvent::User + 1);
-
-//    /// \brief The selected entities.
-//    private: std::vector<Entity> entities;
-
-//    /// \brief Whether the event was generated by the user,
-//    private: bool fromUser{false};
-//  };
+  class EntitiesSelected : public QEvent
+  {
+    /// \brief Constructor
+    /// \param[in] _entities All the selected entities
+    /// \param[in] _fromUser True if the event was directly generated by the
+    /// user, false in case it's been propagated through a different mechanism.
+    public: explicit EntitiesSelected(
+        const std::vector<unsigned int> &_entities,  // NOLINT
+        bool _fromUser = false)
+        : QEvent(kType), entities(_entities), fromUser(_fromUser)
+    {
+    }
+
+    /// \brief Get the data sent with the event.
+    /// \return The entities being selected.
+    public: std::vector<unsigned int> Data() const
+    {
+      return this->entities;
+    }
+
+    /// \brief Get whether the event was generated by the user.
+    /// \return True for the user.
+    public: bool FromUser() const
+    {
+      return this->fromUser;
+    }
+
+    /// \brief Unique type for this event.
+    static const QEvent::Type kType = QEvent::Type(QEvent::User + 1);
+
+    /// \brief The selected entities.
+    private: std::vector<unsigned int> entities;
+
+    /// \brief Whether the event was generated by the user,
+    private: bool fromUser{false};
+  };
 
   /// \brief Event that notifies when all entities have been deselected.
   class DeselectAllEntities : public QEvent
@@ -155,6 +166,51 @@ namespace events
     /// \brief Unique type for this event.
     static const QEvent::Type Type = QEvent::Type(QEvent::User + 3);
   };
+
+  /// \brief Event that notifies when an environment has been loaded into
+  /// the scene. It is sent from the render thread.
+  class SceneGraphLoaded : public QEvent
+  {
+    /// \brief Constructor
+    /// \param[in] _sceneGraph The scene graph of the loaded environment
+    /// \param[in] _entityManager A copy of the entity manager the scene graph
+    /// was rendered with
+    public: SceneGraphLoaded(
+        std::shared_ptr<const tesseract_scene_graph::SceneGraph> _sceneGraph,
+        std::shared_ptr<const tesseract_visualization::EntityManager>
+        _entityManager)
+        : QEvent(kType), sceneGraph(std::move(_sceneGraph)),
+          entityManager(std::move(_entityManager))
+    {
+    }
+
+    /// \brief Get the scene graph of the loaded environment.
+    /// \return The scene graph
+    public: std::shared_ptr<const tesseract_scene_graph::SceneGraph>
+        SceneGraph() const
+    {
+      return this->sceneGraph;
+    }
+
+    /// \brief Get the entity manager the scene graph was rendered with.
+    /// \return The entity manager
+    public: std::shared_ptr<const tesseract_visualization::EntityManager>
+        EntityManager() const
+    {
+      return this->entityManager;
+    }
+
+    /// \brief Unique type for this event.
+    static const QEvent::Type kType = QEvent::Type(QEvent::User + 4);
+
+    /// \brief The scene graph of the loaded environment.
+    private: std::shared_ptr<const tesseract_scene_graph::SceneGraph>
+        sceneGraph;
+
+    /// \brief The entity manager the scene graph was rendered with.
+    private: std::shared_ptr<const tesseract_visualization::EntityManager>
+        entityManager;
+  };
 }
 }  // namespace gui
 }  // namespace tesseract_ignition
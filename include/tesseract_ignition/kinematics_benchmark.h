@@ -0,0 +1,115 @@
+/**
+ * @file kinematics_benchmark.h
+ * @brief Measure the throughput and latency of the kinematic solvers of the environment's groups
+ *
+ * @author Levi Armstrong
+ * @date October 18, 2026
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @copyright Copyright (c) 2020, Southwest Research Institute
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TESSERACT_IGNITION_KINEMATICS_BENCHMARK_H
+#define TESSERACT_IGNITION_KINEMATICS_BENCHMARK_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <tesseract_environment/core/environment.h>
+
+namespace tesseract_ignition
+{
+
+/** @brief Settings used when benchmarking the kinematic solvers */
+struct KinematicsBenchmarkConfig
+{
+  /** @brief The number of calls made to each solver, split across the threads */
+  long samples {10000};
+
+  /** @brief The number of threads, zero uses the hardware concurrency */
+  unsigned threads {0};
+
+  /** @brief The seed of the sampled joint states, the same seed gives the same poses */
+  std::uint32_t seed {5489};
+
+  /** @brief An IK solution whose pose is further than this in meters from the target is not counted */
+  double position_tolerance {1e-4};
+
+  /** @brief An IK solution whose orientation is further than this in radians from the target is not counted */
+  double orientation_tolerance {1e-3};
+};
+
+/** @brief The measurements of one solver of a group */
+struct KinematicsBenchmarkResult
+{
+  std::string group_name;
+  std::string solver_name;
+
+  /** @brief True for an inverse kinematics solver, false for a forward kinematics solver */
+  bool inverse {false};
+
+  /** @brief The number of calls made */
+  long calls {0};
+
+  /** @brief The number of calls that succeeded, for IK at least one solution must reproduce the target pose */
+  long successes {0};
+
+  /** @brief The number of valid solutions returned, for FK this is the number of successful calls */
+  long solutions {0};
+
+  /**
+   * @brief The wall time of the solver calls in seconds, from the first thread starting its calls to the last one
+   * finishing them. Cloning the solvers and checking the IK solutions are not included.
+   */
+  double seconds {0};
+
+  /** @brief The latency percentiles of a single call in microseconds */
+  double latency_p50 {0};
+  double latency_p90 {0};
+  double latency_p99 {0};
+  double latency_max {0};
+
+  /** @brief The number of calls per second across all threads */
+  double getCallsPerSecond() const;
+
+  /** @brief The number of valid solutions per second across all threads */
+  double getSolutionsPerSecond() const;
+
+  /** @brief The fraction of calls which succeeded */
+  double getSuccessRate() const;
+};
+
+/**
+ * @brief Benchmark every forward and inverse kinematics solver available for a group
+ *
+ * Random joint states within the limits are converted to reachable poses with the group's default forward
+ * kinematics. Each forward solver is timed on the joint states and each inverse solver on the poses, seeded with an
+ * unrelated random state. The calls are split across threads, each using its own clone of the solver, and only the
+ * solver call itself is timed.
+ * @param env The environment providing the manipulator manager
+ * @param group_name The group to benchmark
+ * @param config The benchmark settings
+ * @return The results of each solver, empty if the group has no forward kinematics
+ */
+std::vector<KinematicsBenchmarkResult> benchmarkKinematics(const tesseract_environment::Environment& env,
+                                                           const std::string& group_name,
+                                                           const KinematicsBenchmarkConfig& config);
+
+}
+
+#endif // TESSERACT_IGNITION_KINEMATICS_BENCHMARK_H
@@ -0,0 +1,83 @@
+/**
+ * @file package_resolver.h
+ * @brief Find the directories of ROS packages by name
+ *
+ * @author Levi Armstrong
+ * @date October 18, 2026
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @copyright Copyright (c) 2020, Southwest Research Institute
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TESSERACT_IGNITION_PACKAGE_RESOLVER_H
+#define TESSERACT_IGNITION_PACKAGE_RESOLVER_H
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace tesseract_ignition
+{
+
+/**
+ * @brief An index of the packages below a list of search paths
+ *
+ * Each search path is crawled in its own thread the first time a package is looked up. A directory containing a
+ * package.xml is indexed by the name in it and is not searched further, directories containing a CATKIN_IGNORE,
+ * COLCON_IGNORE or AMENT_IGNORE file and hidden directories are skipped. A search path is also indexed by its
+ * directory name, below any package.xml name, so a path pointing directly at a package without a package.xml is
+ * still found. When a name is found more than once the earliest search path wins.
+ *
+ * The index is not changed after it is built, so findPackage may be called from any thread.
+ */
+class PackageResolver
+{
+public:
+  /** @param search_paths The directories to search, in priority order */
+  explicit PackageResolver(std::vector<std::string> search_paths);
+
+  /**
+   * @brief Get the search paths of the environment, TSW_RESOURCE_PATH followed by ROS_PACKAGE_PATH
+   *
+   * TSW_RESOURCE_PATH allows a user defined resource path. When running within a snap the host ros package paths can
+   * be mapped to it.
+   */
+  static std::vector<std::string> getEnvironmentSearchPaths();
+
+  /**
+   * @brief Get the directory of a package, crawling the search paths on the first call
+   * @return The directory of the package, empty if it was not found
+   */
+  std::string findPackage(const std::string& name) const;
+
+  const std::vector<std::string>& getSearchPaths() const;
+
+private:
+  std::vector<std::string> search_paths_;
+
+  mutable std::once_flag crawled_;
+
+  /** @brief The directory of each package name, only written by crawl */
+  mutable std::unordered_map<std::string, std::string> packages_;
+
+  void crawl() const;
+};
+
+}
+
+#endif // TESSERACT_IGNITION_PACKAGE_RESOLVER_H
@@ -78,6 +78,21 @@ namespace tesseract_ignition
      */
     tesseract_environment::Environment::ConstPtr getEnvironmentConst() const;
 
+    /**
+     * @brief Get the entity manager of the entities created for the environment
+     *
+     * This is only safe to use from the rendering thread.
+     */
+    const tesseract_visualization::EntityManager& getEntityManager() const;
+
+    /**
+     * @brief Get the number of times an environment has been loaded into the scene
+     *
+     * This changes when update() loads the environment passed to setEnvironment, which can be used to detect that
+     * the entity manager has been rebuilt.
+     */
+    int getSceneRevision() const;
+
     /** @brief Set Tesseract commands to be applied to the scene and tesseract environment */
     void setEnvironmentCommands(tesseract_environment::Commands commands);
 
@@ -87,6 +102,15 @@ namespace tesseract_ignition
     void setEnvironmentState(const std::vector<std::string>& joint_names,
                            const Eigen::Ref<const Eigen::VectorXd>& joint_values);
 
+    /**
+     * @brief Queue joint values to be applied on the next update
+     *
+     * Values queued between two updates are merged, the last value of each joint wins, and the state is solved
+     * once per update for all of them. Use this for interactive edits like sliders which change faster than the
+     * scene is rendered.
+     */
+    void queueEnvironmentState(const std::unordered_map<std::string, double>& joints);
+
 //    /// \brief Count of pending sensors. Must be called in the rendering thread.
 //    /// \return Number of sensors to be added on the next `Update` call
 //    ///
@@ -164,6 +188,29 @@ namespace tesseract_ignition
     /// \brief Clears the set of selected entities and lowlights all of them.
     void deselectAllEntities();
 
+    /**
+     * @brief Select entities, replacing the current selection
+     *
+     * This is safe to call from any thread. The selection is applied by the next update, requests made between two
+     * updates are collapsed into the last one. An empty vector clears the selection.
+     */
+    void selectEntities(const std::vector<tesseract_visualization::EntityID>& entities);
+
+    /**
+     * @brief Select links by name, replacing the current selection
+     *
+     * This is safe to call from any thread and is applied by the next update like selectEntities. Names which are
+     * not links of the environment are ignored.
+     */
+    void selectLinks(const std::vector<std::string>& link_names);
+
+    /**
+     * @brief Get the number of times update() has applied a selection
+     *
+     * This can be used to detect when to notify others of the selected entities.
+     */
+    int getSelectionRevision() const;
+
     /// \brief Set whether the transform controls are currently being dragged.
     /// \param[in] _active True if active.
     void setTransformActive(bool active);
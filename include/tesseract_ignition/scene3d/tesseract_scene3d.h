@@ -62,6 +62,13 @@ namespace plugins
   ///                          (0.3, 0.3, 0.3, 1.0)
   /// * \<camera_pose\> : Optional starting pose for the camera, defaults to
   ///                     (0, 0, 5, 0, 0, 0)
+  /// * \<picking\> : Optional method used to find what is under the mouse,
+  ///                 "selection_buffer" (default) reads the visual back from an
+  ///                 offscreen render of visual ids, "ray_query" intersects the
+  ///                 triangles of the scene on the CPU.
+  ///
+  /// A left click without dragging selects the link under the mouse by
+  /// sending an EntitiesSelected event, clicking the background deselects all.
   class TesseractScene3D : public ignition::gui::Plugin
   {
     Q_OBJECT
@@ -126,9 +133,20 @@ namespace plugins
 
     /// \brief Retrieve the first point on a surface in the 3D scene hit by a
     /// ray cast from the given 2D screen coordinates.
+    ///
+    /// With selection buffer picking the visual is read from the GPU and the
+    /// point is where the ray enters its bounding box, so no triangles are
+    /// tested on the CPU.
     /// \param[in] _screenPos 2D coordinates on the screen, in pixels.
+    /// \param[out] _visual If not null, set to the visual under the position
+    /// or null if there is none.
     /// \return 3D coordinates of a point in the 3D scene.
-    private: ignition::math::Vector3d ScreenToScene(const ignition::math::Vector2i &_screenPos) const;
+    private: ignition::math::Vector3d ScreenToScene(const ignition::math::Vector2i &_screenPos,
+        ignition::rendering::VisualPtr *_visual = nullptr) const;
+
+    /// \brief Send the selection of a click on a visual to the other plugins
+    /// \param[in] _visual The visual clicked, null deselects all entities
+    private: void SelectVisual(const ignition::rendering::VisualPtr &_visual) const;
 
     /// \brief Render texture id
     public: GLuint textureId = 0u;
@@ -142,6 +160,9 @@ namespace plugins
     /// \brief Initial Camera pose
     public: ignition::math::Pose3d cameraPose = ignition::math::Pose3d(0, 0, 2, 0, 0.4, 0);
 
+    /// \brief Picking method, "selection_buffer" or "ray_query"
+    public: std::string picking = "selection_buffer";
+
     /// \brief Scene background color
     public: ignition::math::Color backgroundColor = ignition::math::Color::Black;
 
@@ -240,6 +261,10 @@ namespace plugins
     /// \param[in] _pose Initical camera pose
     public: void SetCameraPose(const ignition::math::Pose3d &_pose);
 
+    /// \brief Set the picking method used for selection and zoom
+    /// \param[in] _picking "selection_buffer" or "ray_query"
+    public: void SetPicking(const std::string &_picking);
+
     /// \brief Set pose topic to use for updating objects in the scene
     /// The renderer will subscribe to this topic to get pose messages of
     /// visuals in the scene
@@ -0,0 +1,342 @@
+/**
+ * @file acm_generator.h
+ * @brief Utilities for generating the Allowed Collision Matrix by sampling the environment
+ *
+ * @author Levi Armstrong
+ * @date October 18, 2026
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @copyright Copyright (c) 2020, Southwest Research Institute
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TESSERACT_IGNITION_ACM_GENERATOR_H
+#define TESSERACT_IGNITION_ACM_GENERATOR_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <tesseract_collision/core/types.h>
+#include <tesseract_environment/core/environment.h>
+
+namespace tesseract_ignition
+{
+
+/** @brief How the joint states are chosen when sampling the environment */
+enum class ACMSamplingMode : std::uint8_t
+{
+  /** @brief Uniform random states from the state solver */
+  RANDOM = 0,
+
+  /** @brief A scrambled Halton sequence over the active joint limits, deterministic and with even coverage */
+  HALTON = 1
+};
+
+/** @brief Settings used when sampling the environment to generate the Allowed Collision Matrix */
+struct ACMGeneratorConfig
+{
+  /** @brief The maximum number of samples taken for each link pair */
+  long resolution {8000};
+
+  /** @brief A pair in contact in more than this fraction of the samples is always in collision */
+  double always_threshold {0.95};
+
+  /**
+   * @brief The confidence level required to stop sampling a pair before reaching the resolution
+   *
+   * This holds over all the checks made while sampling a pair, see settlePairClass. A value of zero disables early
+   * termination so every pair is sampled resolution times.
+   */
+  double confidence {0.99};
+
+  /**
+   * @brief A pair that was never in contact is settled as never in collision once the upper bound of its
+   * contact probability, at the given confidence, is below this value
+   */
+  double never_tolerance {0.001};
+
+  /** @brief The number of samples taken for every pair before any pair can be settled */
+  long min_samples {100};
+
+  /** @brief Settle pairs whose swept bounding volumes never overlap as never in collision before sampling */
+  bool prune_unreachable_pairs {true};
+
+  /** @brief How the joint states are sampled */
+  ACMSamplingMode sampling_mode {ACMSamplingMode::RANDOM};
+
+  /** @brief The seed of the digit scrambling used by the Halton sequence, the same seed gives the same states */
+  std::uint32_t sampling_seed {5489};
+};
+
+/** @brief The classification of a link pair */
+enum class ACMPairClass : std::uint8_t
+{
+  UNSETTLED = 0,
+  NEVER = 1,
+  SOMETIMES = 2,
+  ALWAYS = 3
+};
+
+/**
+ * @brief Stores the number of samples in which each pair of collision links was found in contact
+ *
+ * Only a hit counter is kept per link pair, stored in a flat upper triangular array, so the memory used
+ * depends on the number of links and not on the number of samples or contacts.
+ */
+class ACMContactCounts
+{
+public:
+  ACMContactCounts() = default;
+
+  /** @param link_names The links to track, normally only the links with collision geometry */
+  explicit ACMContactCounts(std::vector<std::string> link_names);
+
+  /** @brief The links being tracked */
+  const std::vector<std::string>& getLinkNames() const;
+
+  /** @brief The number of link pairs being tracked */
+  std::size_t getPairCount() const;
+
+  /**
+   * @brief Get the index of a link
+   * @return The index, or -1 if the link is not tracked
+   */
+  long getLinkIndex(const std::string& link_name) const;
+
+  /**
+   * @brief Get the flat index of the pair made of links i and j
+   * @param i The index of the first link
+   * @param j The index of the second link, must be different from i
+   */
+  std::size_t getPairIndex(std::size_t i, std::size_t j) const;
+
+  /**
+   * @brief Record the result of a single contact test
+   *
+   * Each pair found in the results is counted once, no matter how many contacts it has. Only the pairs
+   * that are not settled yet are updated.
+   * @param results The contact results of one sample
+   */
+  void addSample(const tesseract_collision::ContactResultMap& results);
+
+  /** @brief The number of samples recorded for the pair */
+  std::uint32_t getSamples(std::size_t pair_index) const;
+
+  /** @brief The number of samples in which the pair was in contact */
+  std::uint32_t getHits(std::size_t pair_index) const;
+
+  /** @brief The classification of the pair */
+  ACMPairClass getPairClass(std::size_t pair_index) const;
+
+  /** @brief Check if the pair is settled, if so it no longer needs to be sampled */
+  bool isSettled(std::size_t pair_index) const;
+
+  /** @brief Check if the pair made of the two links is settled, pairs of untracked links are considered settled */
+  bool isSettled(const std::string& link_name1, const std::string& link_name2) const;
+
+  /**
+   * @brief Add previously recorded samples to a pair, used to seed the counts from the cache
+   * @param pair_index The flat index of the pair
+   * @param hits The number of samples in which the pair was in contact
+   * @param samples The number of samples
+   */
+  void addSamples(std::size_t pair_index, std::uint32_t hits, std::uint32_t samples);
+
+  /** @brief Set the classification of a pair */
+  void setPairClass(std::size_t pair_index, ACMPairClass pair_class);
+
+  /** @brief The number of pairs which are not settled */
+  std::size_t getUnsettledPairCount() const;
+
+  /** @brief The number of pairs which are not settled and include the link */
+  std::size_t getUnsettledPairCount(std::size_t link_index) const;
+
+private:
+  std::vector<std::string> link_names_;
+  std::unordered_map<std::string, std::size_t> link_indices_;
+  std::vector<std::uint32_t> hits_;
+  std::vector<std::uint32_t> samples_;
+  std::vector<ACMPairClass> classes_;
+  std::vector<std::size_t> link_unsettled_;
+  std::size_t unsettled_ {0};
+};
+
+/**
+ * @brief A scrambled Halton low discrepancy sequence in the unit hypercube
+ *
+ * Each dimension uses the radical inverse in a different prime base. The digits of each base are permuted with a
+ * permutation drawn from the seed, which removes the correlation between the higher dimensions of the plain
+ * sequence while keeping it deterministic.
+ */
+class HaltonSequence
+{
+public:
+  /**
+   * @param dimensions The number of dimensions
+   * @param seed The seed of the digit permutations
+   * @param start_index The index of the point before the first one returned, used to continue an earlier sequence
+   */
+  HaltonSequence(std::size_t dimensions, std::uint32_t seed, std::uint64_t start_index = 0);
+
+  /** @brief The next point of the sequence, each coordinate is in [0, 1) */
+  Eigen::VectorXd next();
+
+  /** @brief The index of the last point returned, pass it as the start index to continue the sequence */
+  std::uint64_t getIndex() const;
+
+private:
+  std::vector<std::uint32_t> bases_;
+  std::vector<std::vector<std::uint32_t>> permutations_;
+  std::uint64_t index_ {0};
+};
+
+/** @brief The sample statistics of a link pair stored in the ACM cache */
+struct ACMCacheEntry
+{
+  std::uint32_t hits {0};
+  std::uint32_t samples {0};
+
+  /**
+   * @brief The Halton sequence index the samples were drawn up to, zero for random sampling
+   *
+   * A later generation continues the sequence after it, so the same joint states are not counted twice.
+   */
+  std::uint64_t sequence_end {0};
+};
+
+/**
+ * @brief Stores the sample statistics of link pairs on disk so they can be reused by later ACM generations
+ *
+ * Entries are keyed by a hash of the collision geometry and kinematics of both links, see getPairCacheKey, so an
+ * entry is only found again while neither link has changed.
+ */
+class ACMGeneratorCache
+{
+public:
+  /**
+   * @brief Load the entries from a file, replacing the current entries
+   * @return False if the file could not be read, the cache is then empty
+   */
+  bool load(const std::string& filepath);
+
+  /**
+   * @brief Save the entries to a file
+   * @return False if the file could not be written
+   */
+  bool save(const std::string& filepath) const;
+
+  /**
+   * @brief Find the entry of a pair
+   * @return The entry, or nullptr if the pair is not cached
+   */
+  const ACMCacheEntry* find(std::uint64_t key) const;
+
+  /** @brief Store the entry of a pair, replacing the existing one */
+  void store(std::uint64_t key, const ACMCacheEntry& entry);
+
+  /** @brief The number of entries */
+  std::size_t size() const;
+
+  /** @brief Remove all entries */
+  void clear();
+
+private:
+  std::unordered_map<std::uint64_t, ACMCacheEntry> entries_;
+};
+
+/**
+ * @brief Hash everything that affects the contacts of a link relative to the other links
+ *
+ * This covers the collision geometry of the link and every joint from the link up to the root, including the joint
+ * limits.
+ * @return The hash, or zero if the link has geometry which cannot be hashed and should not be cached
+ */
+std::uint64_t getLinkCacheHash(const tesseract_scene_graph::SceneGraph& scene_graph, const std::string& link_name);
+
+/**
+ * @brief Get the cache key of a pair from the hashes of its links, the contact distance and the sampling settings
+ *
+ * The sampling mode is part of the key, and for the Halton sequence so is its seed, so samples are only combined
+ * with samples drawn the same way.
+ * @return The key, or zero if either link cannot be cached
+ */
+std::uint64_t getPairCacheKey(std::uint64_t link_hash1,
+                              std::uint64_t link_hash2,
+                              double contact_distance,
+                              const ACMGeneratorConfig& config);
+
+/**
+ * @brief Try to settle the classification of a pair from the samples recorded so far
+ *
+ * A pair is settled as ALWAYS or SOMETIMES once the Wilson score interval of its contact probability falls entirely
+ * above or below the always threshold. Since the pair is checked again as samples are added, the interval is only
+ * checked at min_samples times a power of two, and the confidence of each check is raised so the error of all checks
+ * together stays within the configured confidence. A pair that was never in contact is settled as NEVER once the
+ * exact upper bound of its contact probability is below the never tolerance, with the defaults this takes about
+ * 4600 samples.
+ * @return The class of the pair, UNSETTLED if more samples are required
+ */
+ACMPairClass settlePairClass(std::uint32_t hits, std::uint32_t samples, const ACMGeneratorConfig& config);
+
+/**
+ * @brief Classify a pair from its point estimate, used for pairs that reached the resolution without settling
+ */
+ACMPairClass estimatePairClass(std::uint32_t hits, std::uint32_t samples, const ACMGeneratorConfig& config);
+
+/**
+ * @brief Settle the pairs which can never be in contact as NEVER without sampling
+ *
+ * The collision geometry of each link is bounded by a sphere which is then swept through the joints up to the
+ * lowest common ancestor of each pair, over the full range of the joint limits. Spheres are used instead of boxes
+ * because they stay tight when swept around a revolute joint. If the swept volumes of two links do not overlap in
+ * the frame of their common ancestor, no reachable state can bring them into contact. Links under floating or
+ * planar joints, or with unbounded geometry, are never pruned.
+ * @param scene_graph The scene graph providing the links and joint limits
+ * @param counts The pair counts to update
+ * @param margin The contact distance, spheres closer than this are considered overlapping
+ * @return The number of pairs settled
+ */
+std::size_t settleUnreachablePairs(const tesseract_scene_graph::SceneGraph& scene_graph,
+                                   ACMContactCounts& counts,
+                                   double margin = 0);
+
+/**
+ * @brief Sample states of the environment and count the contacts between each pair of collision links
+ *
+ * The environment's allowed collision matrix is ignored while sampling. Pairs are sampled until their class is
+ * settled or the resolution is reached. Pairs that can never reach each other are settled before sampling. Settled
+ * pairs are skipped by the contact manager and links whose pairs are all settled are removed from its active
+ * objects, so later samples only check the pairs still in question.
+ * On return every pair is classified.
+ *
+ * If a cache is provided the pairs found in it start from their cached samples, so pairs whose links did not
+ * change are usually settled without sampling. On return the cache only holds the samples of the sampled pairs of
+ * this environment, entries of other pairs are removed. When sampling with the Halton sequence it is continued after
+ * the last index of the cached pairs, so the new samples are not repeats of the cached ones.
+ * @param env The environment to sample
+ * @param config The sampling settings
+ * @param cache The optional cache of pair samples
+ * @return The contact counts for all links with collision geometry
+ */
+ACMContactCounts sampleContacts(const tesseract_environment::Environment& env,
+                                const ACMGeneratorConfig& config,
+                                ACMGeneratorCache* cache = nullptr);
+
+}
+
+#endif // TESSERACT_IGNITION_ACM_GENERATOR_H
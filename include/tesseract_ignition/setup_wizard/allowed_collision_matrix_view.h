@@ -0,0 +1,117 @@
+/**
+ * @file allowed_collision_matrix_view.h
+ * @brief A Qt Quick item drawing the Tesseract Allowed Collision Matrix as a link by link matrix
+ *
+ * @author Levi Armstrong
+ * @date October 18, 2026
+ * @version TODO
+ * @bug No known bugs
+ *
+ *
+ * @copyright Copyright (c) 2020, Southwest Research Institute
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TESSERACT_IGNITION_ALLOWED_COLLISION_MATRIX_VIEW_H
+#define TESSERACT_IGNITION_ALLOWED_COLLISION_MATRIX_VIEW_H
+
+#ifndef Q_MOC_RUN
+#include <tesseract_ignition/setup_wizard/models/allowed_collision_matrix_model.h>
+#include <QQuickPaintedItem>
+#include <QImage>
+#include <QHash>
+#include <QPointer>
+#endif
+
+namespace tesseract_ignition
+{
+/**
+ * @brief Draws the allowed collision matrix as an image with one pixel per link pair
+ *
+ * The matrix is stored as an 8 bit indexed image holding a reason code per pair, so it uses one byte per pair and
+ * is drawn with a single scaled blit no matter how many entries there are. The item follows the changes of the
+ * model row by row, only a model reset rebuilds the whole matrix.
+ */
+class AllowedCollisionMatrixView : public QQuickPaintedItem
+{
+  Q_OBJECT
+  Q_PROPERTY(tesseract_ignition::AllowedCollisionMatrixModel* model READ model WRITE setModel NOTIFY modelChanged)
+  Q_PROPERTY(int linkCount READ linkCount NOTIFY linkCountChanged)
+
+public:
+  /** @brief The reason codes stored per pair, also used as the color table index */
+  enum ReasonCode : uchar
+  {
+    NONE = 0,
+    ADJACENT = 1,
+    NEVER = 2,
+    ALWAYS = 3,
+    USER = 4,
+    DIAGONAL = 5
+  };
+
+  explicit AllowedCollisionMatrixView(QQuickItem *parent = nullptr);
+  ~AllowedCollisionMatrixView() override = default;
+
+  AllowedCollisionMatrixModel* model() const;
+  void setModel(AllowedCollisionMatrixModel* model);
+
+  /** @brief The number of links shown along each side of the matrix */
+  int linkCount() const;
+
+  /** @brief The name of the link at an index of the matrix */
+  Q_INVOKABLE QString linkName(int index) const;
+
+  /** @brief Get the reason code of a reason string */
+  static ReasonCode getReasonCode(const QString& reason);
+
+  void paint(QPainter *painter) override;
+
+Q_SIGNALS:
+  void modelChanged();
+  void linkCountChanged();
+
+  /**
+   * @brief Emitted when a cell of the matrix is clicked
+   * @param link1 The link of the row
+   * @param link2 The link of the column
+   * @param row The row of the pair in the model, -1 if the pair is not allowed
+   */
+  void pairClicked(const QString& link1, const QString& link2, int row);
+
+protected:
+  void mousePressEvent(QMouseEvent *event) override;
+
+private Q_SLOTS:
+  void rebuild();
+  void onRowsChanged(const QModelIndex &parent, int first, int last);
+  void onRowsAboutToBeRemoved(const QModelIndex &parent, int first, int last);
+  void onDataChanged(const QModelIndex &top_left, const QModelIndex &bottom_right);
+
+private:
+  QPointer<AllowedCollisionMatrixModel> model_;
+  QStringList link_names_;
+  QHash<QString, int> link_indices_;
+  QImage matrix_;
+
+  /** @brief Set the reason code of a pair in both halves of the matrix, returns false if a link is not shown */
+  bool setPairCode(const QString& link1, const QString& link2, ReasonCode code);
+
+  /** @brief The rectangle the matrix is drawn in, kept square and centered in the item */
+  QRectF matrixRect() const;
+};
+}
+
+#endif // TESSERACT_IGNITION_ALLOWED_COLLISION_MATRIX_VIEW_H
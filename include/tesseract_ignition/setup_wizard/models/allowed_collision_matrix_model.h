@@ -1,6 +1,6 @@
 /**
  * @file allowed_collision_matrix_model.h
- * @brief A Qt Standard Item Model for Tesseract Allowed Collision Matrix
+ * @brief A Qt Table Model for Tesseract Allowed Collision Matrix
  *
  * @author Levi Armstrong
  * @date May 14, 2020
@@ -28,13 +28,20 @@
 
 #ifndef Q_MOC_RUN
 #include <tesseract_environment/core/environment.h>
-#include <QStandardItemModel>
+#include <QAbstractTableModel>
 #include <QMetaType>
+#include <vector>
 #endif
 
 namespace tesseract_ignition
 {
-class AllowedCollisionMatrixModel : public QStandardItemModel
+/**
+ * @brief A table model of the allowed collision matrix entries
+ *
+ * The entries are kept in a flat vector sorted by link names, with the two link names of an entry in sorted order,
+ * so entries are found with a binary search and adding or removing one only notifies the views of that row.
+ */
+class AllowedCollisionMatrixModel : public QAbstractTableModel
 {
     Q_OBJECT
 public:
@@ -44,6 +51,14 @@ public:
       ReasonRole = Qt::UserRole + 3
   };
 
+  /** @brief An allowed collision entry, link1 is always less than link2 */
+  struct Entry
+  {
+    QString link1;
+    QString link2;
+    QString reason;
+  };
+
   AllowedCollisionMatrixModel(QObject *parent = nullptr);
   AllowedCollisionMatrixModel(const AllowedCollisionMatrixModel &other);
   AllowedCollisionMatrixModel &operator=(const AllowedCollisionMatrixModel &other);
@@ -53,11 +68,43 @@ public:
   Q_INVOKABLE void add(const QString& link_name1, const QString& link_name2, const QString& reason);
   Q_INVOKABLE void clear();
 
+  /**
+   * @brief Replace all entries with the provided entries
+   *
+   * Only the pairs that differ between the current and new entries are changed, and the changes are applied to
+   * the environment with a single call to applyCommands followed by one model reset.
+   * @param entries The new entries, the link order and entry order do not matter
+   */
+  void apply(std::vector<Entry> entries);
+
+  /**
+   * @brief Find the row of the entry for a pair of links, the order of the links does not matter
+   * @return The row, or -1 if the pair is not in the model
+   */
+  Q_INVOKABLE int find(const QString& link_name1, const QString& link_name2) const;
+
+  /** @brief The environment the entries belong to */
+  tesseract_environment::Environment::ConstPtr getEnvironment() const;
+
+  /** @brief The entries sorted by link names */
+  const std::vector<Entry>& getEntries() const;
+
   QHash<int, QByteArray> roleNames() const override;
+  int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+  int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+  QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
   bool removeRows(int row, int count, const QModelIndex &parent = QModelIndex()) override;
 
 private:
   tesseract_environment::Environment::Ptr env_ {nullptr};
+  std::vector<Entry> entries_;
+
+  /** @brief Sort the entries and their link names, then remove duplicate pairs keeping the last one */
+  static void normalize(std::vector<Entry>& entries);
+
+  /** @brief The first entry not less than the pair, the link names must already be in sorted order */
+  std::vector<Entry>::const_iterator lowerBound(const QString& link_name1, const QString& link_name2) const;
 };
 }
 Q_DECLARE_METATYPE(tesseract_ignition::AllowedCollisionMatrixModel)
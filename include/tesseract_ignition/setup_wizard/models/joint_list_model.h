@@ -53,6 +53,15 @@ public:
   Q_INVOKABLE void add(tesseract_scene_graph::Joint::ConstPtr joint);
   Q_INVOKABLE void clear();
 
+  /**
+   * @brief Set the value of the joint in a row
+   * @return False if the row does not exist
+   */
+  bool setValue(int row, double value);
+
+  /** @brief The name of the joint in a row, empty if the row does not exist */
+  QString getName(int row) const;
+
   QHash<int, QByteArray> roleNames() const override;
 
 private:
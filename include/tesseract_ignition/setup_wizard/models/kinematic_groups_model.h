@@ -1,6 +1,6 @@
 /**
  * @file kinematic_groups_model.h
- * @brief A Qt Standard Item Model for Tesseract Kinematic Groups
+ * @brief A Qt List Model for Tesseract Kinematic Groups
  *
  * @author Levi Armstrong
  * @date May 14, 2020
@@ -28,14 +28,25 @@
 
 #ifndef Q_MOC_RUN
 #include <tesseract_environment/core/environment.h>
-#include <QStandardItemModel>
+#include <QAbstractListModel>
+#include <QStringList>
 #include <QMetaType>
+#include <future>
+#include <map>
+#include <vector>
 #endif
 
 namespace tesseract_ignition
 {
 
-class KinematicGroupsModel : public QStandardItemModel
+/**
+ * @brief A list model of the kinematic groups
+ *
+ * The contents of each group are exposed as string lists through the joints, links, base and tip roles so views do
+ * not need to parse them. The data role still provides them joined with commas for display. The joints of a chain
+ * are read from its kinematics solver, so they are only available once the group is Ready.
+ */
+class KinematicGroupsModel : public QAbstractListModel
 {
     Q_OBJECT
 public:
@@ -43,22 +54,102 @@ public:
   enum KinematicGroupsRoles {
       NameRole = Qt::UserRole + 1,
       TypeRole = Qt::UserRole + 2,
-      DataRole = Qt::UserRole + 3
+      DataRole = Qt::UserRole + 3,
+      StatusRole = Qt::UserRole + 4,
+      JointsRole = Qt::UserRole + 5,
+      LinksRole = Qt::UserRole + 6,
+      BaseLinkRole = Qt::UserRole + 7,
+      TipLinkRole = Qt::UserRole + 8
+  };
+
+  /** @brief A kinematic group, data holds the base and tip links, joints or links depending on the type */
+  struct Group
+  {
+    QString name;
+    QString type;
+    QStringList data;
+    QString status;
+
+    /** @brief The joints of the group, for a chain these come from its solver and are empty until it is created */
+    QStringList joints;
   };
 
   KinematicGroupsModel(QObject *parent = nullptr);
   KinematicGroupsModel(const KinematicGroupsModel &other);
   KinematicGroupsModel &operator=(const KinematicGroupsModel &other);
-  ~KinematicGroupsModel() override = default;
+  ~KinematicGroupsModel() override;
 
   Q_INVOKABLE void setEnvironment(tesseract_environment::Environment::Ptr env);
+  Q_INVOKABLE void clear();
+
+  /** @brief The name of the group in a row, empty if the row does not exist */
+  Q_INVOKABLE QString getName(int row) const;
+
+  /**
+   * @brief Add or replace a kinematic group
+   *
+   * The kinematics solvers of chain and joint list groups are created on a background thread. The row is added
+   * right away with a Pending status which changes to Ready or Failed once the solvers are created. Solvers are
+   * cached by group name, type, data and solver name so adding the same group again does not create them again,
+   * unless creating them failed. Link list groups are added right away since no solver is created for them yet.
+   */
   Q_INVOKABLE void add(const QString& group_name, const QString& type, const QStringList& data);
 
   QHash<int, QByteArray> roleNames() const override;
+  int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
   bool removeRows(int row, int count, const QModelIndex &parent = QModelIndex()) override;
 
 private:
+  struct Solvers
+  {
+    tesseract_kinematics::ForwardKinematics::Ptr fwd_kin;
+    tesseract_kinematics::InverseKinematics::Ptr inv_kin;
+  };
+
   tesseract_environment::Environment::Ptr env_ {nullptr};
+  std::vector<Group> groups_;
+
+  /**
+   * @brief The solvers created so far with at least one solver, keyed by group name, type, data, solver names and
+   * environment revision
+   */
+  std::map<std::string, Solvers> solver_cache_;
+
+  /** @brief The environment revision the cached solvers were created for, the cache is cleared when it changes */
+  int solver_cache_revision_ {-1};
+
+  /** @brief The id of the latest solver creation task of each pending group */
+  std::map<QString, std::uint64_t> pending_;
+
+  /** @brief The solver creation tasks which may still be running */
+  std::vector<std::future<void>> tasks_;
+
+  std::uint64_t last_task_id_ {0};
+
+  /** @brief Add the solvers and group to the manipulator manager, returns false if there is no solver */
+  bool addGroup(const QString& group_name, const QString& type, const QStringList& data, const Solvers& solvers);
+
+  /** @brief Called on the GUI thread once the solvers of a group are created */
+  void onSolversCreated(const QString& group_name,
+                        const QString& type,
+                        const QStringList& data,
+                        const std::string& key,
+                        std::uint64_t task_id,
+                        const Solvers& solvers);
+
+  /** @brief Add a row or update the existing row of the group */
+  void setRow(const QString& group_name,
+              const QString& type,
+              const QStringList& data,
+              const QString& status,
+              const QStringList& joints = QStringList());
+
+  /** @brief Get the joints of a group, a chain's are taken from its solvers */
+  static QStringList getJoints(const QString& type, const QStringList& data, const Solvers& solvers);
+
+  /** @brief Get the row of a group, -1 if not found */
+  int findRow(const QString& group_name) const;
 };
 }
 #endif // TESSERACT_IGNITION_KINEMATIC_GROUPS_MODEL_H
@@ -28,9 +28,13 @@
 
 #ifndef Q_MOC_RUN
 #include <tesseract_environment/core/environment.h>
+#include <tesseract_ignition/setup_wizard/opw_parameter_fit.h>
 #include <QStandardItemModel>
 #include <QMetaType>
 #include <QMap>
+#include <future>
+#include <map>
+#include <vector>
 #endif
 
 namespace tesseract_ignition
@@ -45,13 +49,14 @@ public:
       GroupNameRole = Qt::UserRole + 1,
       KinematicParametersRole = Qt::UserRole + 2,
       JointOffsetRole = Qt::UserRole + 3,
-      JointCorrectionRole = Qt::UserRole + 4
+      JointCorrectionRole = Qt::UserRole + 4,
+      ValidationRole = Qt::UserRole + 5
   };
 
   OPWKinematicsModel(QObject *parent = nullptr);
   OPWKinematicsModel(const OPWKinematicsModel &other);
   OPWKinematicsModel &operator=(const OPWKinematicsModel &other);
-  ~OPWKinematicsModel() override = default;
+  ~OPWKinematicsModel() override;
 
   Q_INVOKABLE void setEnvironment(tesseract_environment::Environment::Ptr env);
   Q_INVOKABLE void add(const QString& group_name,
@@ -60,17 +65,58 @@ public:
                        double o1, double o2, double o3, double o4, double o5, double o6,
                        int sc1, int sc2, int sc3, int sc4, int sc5, int sc6);
 
+  /**
+   * @brief Fit the OPW parameters of a group by sampling the forward kinematics of its chain
+   *
+   * The fit runs on a background thread. On success the parameters are added as if entered by hand along with their
+   * validation results, otherwise the reason is logged.
+   */
+  Q_INVOKABLE void fit(const QString& group_name);
+
   QHash<int, QByteArray> roleNames() const override;
   bool removeRows(int row, int count, const QModelIndex &parent = QModelIndex()) override;
 
 private:
   tesseract_environment::Environment::Ptr env_ {nullptr};
 
+  /** @brief The id of the latest fit or validation of each group */
+  std::map<QString, std::uint64_t> pending_;
+
+  /** @brief The fits and validations which may still be running */
+  std::vector<std::future<void>> tasks_;
+
+  std::uint64_t last_task_id_ {0};
+
   /**
    * @brief A helper function to add the opw data to the model.
    * @param opw OPW Kinematics data to be added
    */
   void addItem(const QString &group_name, const tesseract_scene_graph::OPWKinematicParameters& opw);
+
+  /** @brief Set the parameters of a group in the manipulator manager and the model */
+  void setParameters(const QString &group_name, const tesseract_scene_graph::OPWKinematicParameters& opw);
+
+  /**
+   * @brief Start a background IK and FK round trip validation of the parameters of a group
+   *
+   * The row of the group shows Validating until the result replaces it with a summary of the round trip errors.
+   */
+  void validate(const QString &group_name, const tesseract_scene_graph::OPWKinematicParameters& opw);
+
+  /** @brief Start a background task for a group, superseding any task already running for it */
+  std::uint64_t startTask(const QString &group_name);
+
+  /** @brief Called on the GUI thread with the result of a fit */
+  void onFitted(const QString &group_name, std::uint64_t task_id, const OPWFitResult& result);
+
+  /** @brief Called on the GUI thread with the result of a validation */
+  void onValidated(const QString &group_name, std::uint64_t task_id, const OPWValidationResult& result);
+
+  /** @brief Show a validation summary in the row of a group */
+  void setValidation(const QString &group_name, const QString &validation);
+
+  /** @brief Get the row item of a group, nullptr if not found */
+  QStandardItem* findItem(const QString &group_name) const;
 };
 
 }
@@ -1,6 +1,6 @@
 /**
  * @file user_defined_joint_states_model.h
- * @brief A Qt Standard Item Model for User Defined Group Joint States
+ * @brief A Qt List Model for User Defined Group Joint States
  *
  * @author Levi Armstrong
  * @date May 14, 2020
@@ -28,15 +28,24 @@
 
 #ifndef Q_MOC_RUN
 #include <tesseract_environment/core/environment.h>
-#include <QStandardItemModel>
+#include <QAbstractListModel>
 #include <QMetaType>
 #include <QMap>
+#include <future>
+#include <map>
+#include <vector>
 #endif
 
 namespace tesseract_ignition
 {
 
-class UserDefinedJointStatesModel : public QStandardItemModel
+/**
+ * @brief A list model of the user defined joint states
+ *
+ * Each row only stores the group and state names, the joint names and values are read from the manipulator manager
+ * and formatted when a view asks for them, so loading many states does not build their display strings up front.
+ */
+class UserDefinedJointStatesModel : public QAbstractListModel
 {
     Q_OBJECT
 public:
@@ -45,25 +54,98 @@ public:
       GroupNameRole = Qt::UserRole + 1,
       StateNameRole = Qt::UserRole + 2,
       JointNamesRole = Qt::UserRole + 3,
-      JointValuesRole = Qt::UserRole + 4
+      JointValuesRole = Qt::UserRole + 4,
+      CollisionStatusRole = Qt::UserRole + 5,
+      MinDistanceRole = Qt::UserRole + 6,
+      CollisionPairsRole = Qt::UserRole + 7
   };
 
+  /** @brief States closer than this to a collision report their distance and pairs */
+  static constexpr double COLLISION_CHECK_DISTANCE = 0.05;
+
   UserDefinedJointStatesModel(QObject *parent = nullptr);
   UserDefinedJointStatesModel(const UserDefinedJointStatesModel &other);
   UserDefinedJointStatesModel &operator=(const UserDefinedJointStatesModel &other);
-  ~UserDefinedJointStatesModel() override = default;
+  ~UserDefinedJointStatesModel() override;
 
   Q_INVOKABLE void setEnvironment(tesseract_environment::Environment::Ptr env);
+  Q_INVOKABLE void clear();
+
+  /**
+   * @brief Add or replace a joint state
+   *
+   * The state is collision checked on a background thread against the current allowed collision matrix. Its row
+   * shows a Checking status until the result replaces it with Clear, Near or Collision, along with the minimum
+   * distance and the pairs closer than COLLISION_CHECK_DISTANCE.
+   */
   Q_INVOKABLE void add(const QString& group_name,
                        const QString& state_name,
                        const QStringList &joint_names,
                        const QStringList &joint_values);
 
+  /**
+   * @brief Import joint states from a CSV file
+   *
+   * Each line holds the group name, the state name and then pairs of joint name and value:
+   * group_name,state_name,joint_name,joint_value,... The file is read line by line straight into the manipulator
+   * manager and the new states are inserted as one batch of rows at the end. Imported states are not collision
+   * checked, the rows of states the file replaces lose their collision result and the other rows keep theirs.
+   * @return The number of states imported, or -1 if the file could not be opened
+   */
+  int importCSV(const QString& filepath);
+
+  /**
+   * @brief Export all joint states to a CSV file in the format read by importCSV
+   * @return False if the file could not be written
+   */
+  bool exportCSV(const QString& filepath) const;
+
   QHash<int, QByteArray> roleNames() const override;
+  int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
   bool removeRows(int row, int count, const QModelIndex &parent = QModelIndex()) override;
 
 private:
+  /** @brief The result of a collision check */
+  struct CollisionCheckResult
+  {
+    QString status;
+    QString min_distance;
+    QString pairs;
+  };
+
+  struct Row
+  {
+    QString group_name;
+    QString state_name;
+    CollisionCheckResult collision;
+  };
+
   tesseract_environment::Environment::Ptr env_ {nullptr};
+  std::vector<Row> rows_;
+
+  /** @brief The id of the latest collision check of each state, keyed by group and state name */
+  std::map<std::pair<QString, QString>, std::uint64_t> pending_;
+
+  /** @brief The collision checks which may still be running */
+  std::vector<std::future<void>> tasks_;
+
+  std::uint64_t last_task_id_ {0};
+
+  /** @brief Rebuild the rows from the manipulator manager */
+  void resetRows();
+
+  /** @brief Get the row of a state, -1 if not found */
+  int findRow(const QString& group_name, const QString& state_name) const;
+
+  /** @brief Start a background collision check of a state */
+  void checkCollision(const QString& group_name, const QString& state_name, const tesseract_scene_graph::GroupsJointState& state);
+
+  /** @brief Called on the GUI thread with the result of a collision check */
+  void onCollisionChecked(const QString& group_name, const QString& state_name, std::uint64_t task_id, const CollisionCheckResult& result);
+
+  /** @brief Show a collision check result in the row of a state */
+  void setCollisionResult(const QString& group_name, const QString& state_name, const CollisionCheckResult& result);
 };
 
 }
@@ -1,6 +1,6 @@
 /**
  * @file user_defined_tcp_model.h
- * @brief A Qt Standard Item Model for User Defined Group Tool Center Points
+ * @brief A Qt List Model for User Defined Group Tool Center Points
  *
  * @author Levi Armstrong
  * @date May 14, 2020
@@ -28,15 +28,22 @@
 
 #ifndef Q_MOC_RUN
 #include <tesseract_environment/core/environment.h>
-#include <QStandardItemModel>
+#include <QAbstractListModel>
 #include <QMetaType>
 #include <QMap>
+#include <vector>
 #endif
 
 namespace tesseract_ignition
 {
 
-class UserDefinedTCPModel : public QStandardItemModel
+/**
+ * @brief A list model of the user defined tool center points
+ *
+ * Each row only stores the group and tcp names, the position and orientation are read from the manipulator manager
+ * and formatted when a view asks for them.
+ */
+class UserDefinedTCPModel : public QAbstractListModel
 {
     Q_OBJECT
 public:
@@ -54,16 +61,47 @@ public:
   ~UserDefinedTCPModel() override = default;
 
   Q_INVOKABLE void setEnvironment(tesseract_environment::Environment::Ptr env);
+  Q_INVOKABLE void clear();
   Q_INVOKABLE void add(const QString& group_name,
                        const QString& tcp_name,
                        const QVector3D &position,
                        const QVector3D &orientation);
 
+  /**
+   * @brief Import tool center points from a CSV file
+   *
+   * Each line holds group_name,tcp_name,x,y,z,roll,pitch,yaw with the angles in radians. The file is read line by
+   * line straight into the manipulator manager and the model is reset once at the end.
+   * @return The number of tool center points imported, or -1 if the file could not be opened
+   */
+  int importCSV(const QString& filepath);
+
+  /**
+   * @brief Export all tool center points to a CSV file in the format read by importCSV
+   * @return False if the file could not be written
+   */
+  bool exportCSV(const QString& filepath) const;
+
   QHash<int, QByteArray> roleNames() const override;
+  int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
   bool removeRows(int row, int count, const QModelIndex &parent = QModelIndex()) override;
 
 private:
+  struct Row
+  {
+    QString group_name;
+    QString tcp_name;
+  };
+
   tesseract_environment::Environment::Ptr env_ {nullptr};
+  std::vector<Row> rows_;
+
+  /** @brief Rebuild the rows from the manipulator manager */
+  void resetRows();
+
+  /** @brief Get the row of a tool center point, -1 if not found */
+  int findRow(const QString& group_name, const QString& tcp_name) const;
 };
 
 }
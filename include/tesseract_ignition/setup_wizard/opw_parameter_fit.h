@@ -0,0 +1,182 @@
+/**
+ * @file opw_parameter_fit.h
+ * @brief Utilities for fitting and validating OPW kinematic parameters against the kinematic chain of a group
+ *
+ * @author Levi Armstrong
+ * @date October 18, 2026
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @copyright Copyright (c) 2020, Southwest Research Institute
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TESSERACT_IGNITION_OPW_PARAMETER_FIT_H
+#define TESSERACT_IGNITION_OPW_PARAMETER_FIT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <tesseract_environment/core/environment.h>
+#include <tesseract_kinematics/core/forward_kinematics.h>
+
+namespace tesseract_ignition
+{
+
+/** @brief Settings used when fitting and validating OPW kinematic parameters */
+struct OPWFitConfig
+{
+  /** @brief The number of forward kinematics samples each candidate is screened against */
+  long screen_samples {40};
+
+  /** @brief The number of Levenberg-Marquardt iterations used to screen each candidate */
+  int screen_iterations {25};
+
+  /** @brief The number of forward kinematics samples the best candidate is refined against */
+  long fit_samples {250};
+
+  /** @brief The maximum number of Levenberg-Marquardt iterations used to refine the best candidate */
+  int fit_iterations {200};
+
+  /** @brief The number of random poses used to validate the parameters with an IK and FK round trip */
+  long validation_samples {5000};
+
+  /** @brief A round trip with a larger position error in meters is a failure */
+  double position_tolerance {1e-4};
+
+  /** @brief A round trip with a larger orientation error in radians is a failure */
+  double orientation_tolerance {1e-3};
+
+  /** @brief The fraction of validation round trips which must succeed for a fit to succeed */
+  double min_success_rate {0.99};
+
+  /** @brief The seed of the joint states sampled for the fit and the validation */
+  std::uint32_t seed {5489};
+
+  /** @brief The number of threads, zero uses the hardware concurrency */
+  unsigned threads {0};
+};
+
+/** @brief The joint origin and axis of a chain joint, expressed in the base link frame */
+struct OPWJointFrame
+{
+  Eigen::Vector3d origin {Eigen::Vector3d::Zero()};
+  Eigen::Vector3d axis {Eigen::Vector3d::UnitZ()};
+};
+
+/** @brief The statistics of the IK and FK round trip errors of a set of OPW parameters */
+struct OPWValidationResult
+{
+  /** @brief The number of poses checked */
+  long samples {0};
+
+  /** @brief The number of poses for which IK found a solution reproducing the pose within tolerance */
+  long successes {0};
+
+  /** @brief The number of poses for which IK returned no valid solution */
+  long no_solution {0};
+
+  double position_mean {0};
+  double position_p95 {0};
+  double position_max {0};
+  double orientation_mean {0};
+  double orientation_p95 {0};
+  double orientation_max {0};
+
+  /** @brief The fraction of poses which succeeded */
+  double getSuccessRate() const;
+};
+
+/** @brief The result of fitting OPW parameters to a kinematic chain */
+struct OPWFitResult
+{
+  /**
+   * @brief True if the fitted parameters reproduce the chain within tolerance and at least min_success_rate of the
+   * validation round trips succeed
+   */
+  bool success {false};
+
+  /** @brief Describes why the fit failed, empty on success */
+  std::string message;
+
+  /** @brief The best parameters found, valid even if the fit failed */
+  tesseract_scene_graph::OPWKinematicParameters parameters;
+
+  /** @brief The RMS position error in meters of the fitted model over the fit samples */
+  double position_rms {0};
+
+  /** @brief The RMS orientation error in radians of the fitted model over the fit samples */
+  double orientation_rms {0};
+
+  /** @brief The round trip statistics of the fitted parameters */
+  OPWValidationResult validation;
+};
+
+/**
+ * @brief Get the joint frames of a chain in its zero state, used as the geometric starting point of the fit
+ * @param env The environment providing the scene graph and state solver
+ * @param fwd_kin The forward kinematics of the chain
+ * @return The frame of each joint expressed in the base link frame, empty if a joint is missing
+ */
+std::vector<OPWJointFrame> getOPWJointFrames(const tesseract_environment::Environment& env,
+                                             const tesseract_kinematics::ForwardKinematics& fwd_kin);
+
+/**
+ * @brief Get the joint limits of a chain from the scene graph
+ *
+ * Joints without limits, such as continuous joints, are given the range [-pi, pi].
+ * @return A matrix with the lower limits in the first column and upper limits in the second
+ */
+Eigen::MatrixX2d getOPWJointLimits(const tesseract_environment::Environment& env,
+                                   const tesseract_kinematics::ForwardKinematics& fwd_kin);
+
+/**
+ * @brief Check the parameters with an IK and FK round trip over random joint states
+ *
+ * Each sampled state is converted to a pose with the chain's forward kinematics, solved with OPW inverse kinematics,
+ * and each solution is converted back with the chain's forward kinematics. The error of a pose is that of its closest
+ * solution. The samples are split across threads, each using its own clone of the forward kinematics.
+ * @param fwd_kin The forward kinematics of the chain, treated as ground truth
+ * @param limits The joint limits to sample within
+ * @param parameters The OPW parameters to check
+ * @param config The validation settings
+ */
+OPWValidationResult validateOPWParameters(const tesseract_kinematics::ForwardKinematics& fwd_kin,
+                                          const Eigen::MatrixX2d& limits,
+                                          const tesseract_scene_graph::OPWKinematicParameters& parameters,
+                                          const OPWFitConfig& config);
+
+/**
+ * @brief Fit the OPW parameters of a six axis chain by sampling its forward kinematics
+ *
+ * The link lengths are first estimated from the joint frames in the zero state. The sign corrections and the
+ * offsets of joints two and three are discrete choices the least squares problem cannot make, so every combination
+ * of sign correction and a few offset starting points is screened with a short Levenberg-Marquardt run on a small
+ * sample set, in parallel. The best candidate is then refined on the full sample set and validated with
+ * validateOPWParameters.
+ * @param fwd_kin The forward kinematics of the chain
+ * @param limits The joint limits to sample within
+ * @param frames The joint frames of the chain in the zero state, see getOPWJointFrames
+ * @param config The fit settings
+ */
+OPWFitResult fitOPWParameters(const tesseract_kinematics::ForwardKinematics& fwd_kin,
+                              const Eigen::MatrixX2d& limits,
+                              const std::vector<OPWJointFrame>& frames,
+                              const OPWFitConfig& config);
+
+}
+
+#endif // TESSERACT_IGNITION_OPW_PARAMETER_FIT_H
@@ -2,6 +2,7 @@ import QtQuick 2.4
 import QtQuick.Controls 1.4 as QC1
 import QtQuick.Controls 2.2
 import QtQuick.Layouts 1.3
+import AllowedCollisionMatrixView 1.0
 
 Item {
 
@@ -9,6 +10,9 @@ Item {
     property alias acmTableView: acmTableView
     property alias generateButton: generateButton
     property alias slider: slider
+    property alias samplingComboBox: samplingComboBox
+    property alias matrixSwitch: matrixSwitch
+    property alias matrixView: matrixView
 
     id: acmEditorPage
 
@@ -17,7 +21,7 @@ Item {
         from: 1000
         value: 8000
         to: 10000
-        anchors.right: generateButton.left
+        anchors.right: samplingComboBox.left
         anchors.rightMargin: 5
         anchors.left: label.right
         anchors.leftMargin: 5
@@ -37,6 +41,16 @@ Item {
         anchors.verticalCenter: slider.verticalCenter
     }
 
+    ComboBox {
+        id: samplingComboBox
+        width: 100
+        model: ["Random", "Halton"]
+        currentIndex: 1
+        anchors.right: generateButton.left
+        anchors.rightMargin: 5
+        anchors.verticalCenter: slider.verticalCenter
+    }
+
     Button {
         id: generateButton
         x: 310
@@ -64,6 +78,7 @@ Item {
         anchors.top: slider.bottom
         anchors.topMargin: 10
         model: acmModel
+        visible: !matrixSwitch.checked
         onModelChanged: busyIndicator.running = false
 
         QC1.TableViewColumn {
@@ -86,6 +101,28 @@ Item {
         }
     }
 
+    AllowedCollisionMatrixView {
+        id: matrixView
+        model: acmModel
+        visible: matrixSwitch.checked
+        anchors.bottom: removeButton.top
+        anchors.bottomMargin: 6
+        anchors.right: parent.right
+        anchors.rightMargin: 5
+        anchors.left: parent.left
+        anchors.leftMargin: 5
+        anchors.top: slider.bottom
+        anchors.topMargin: 10
+    }
+
+    Switch {
+        id: matrixSwitch
+        text: qsTr("Matrix")
+        anchors.left: parent.left
+        anchors.leftMargin: 5
+        anchors.verticalCenter: removeButton.verticalCenter
+    }
+
     Button {
         id: removeButton
         x: 308
@@ -99,13 +136,22 @@ Item {
 
     Connections {
         target: acmTableView
-        onClicked: TesseractSetupWizard.onSelectionChangedACM(
+        onClicked: TesseractSetupWizard.onClickedACMEntry(
                        acmTableView.currentRow)
     }
 
+    Connections {
+        target: matrixView
+        onPairClicked: {
+            acmTableView.currentRow = row
+            TesseractSetupWizard.onClickedACMEntry(row)
+        }
+    }
+
     Connections {
         target: generateButton
-        onClicked: TesseractSetupWizard.onGenerateACM(slider.value)
+        onClicked: TesseractSetupWizard.onGenerateACM(
+                       slider.value, samplingComboBox.currentIndex)
     }
 
     Connections {
@@ -7,7 +7,10 @@ KinematicGroupsForm {
     linkListView.delegate: ItemDelegate {
         text: display
         width: parent.width
-        onClicked: linkListView.currentIndex = index
+        onClicked: {
+            linkListView.currentIndex = index
+            TesseractSetupWizard.onClickedLink(display)
+        }
     }
 
     jointListView.delegate: ItemDelegate {
@@ -368,7 +368,13 @@ Item {
                 id: dataColumn
                 role: "data"
                 title: "Data"
-                width: groupsTableView.viewport.width - nameColumn.width - typeColumn.width
+                width: groupsTableView.viewport.width - nameColumn.width - typeColumn.width - statusColumn.width
+            }
+            QC1.TableViewColumn {
+                id: statusColumn
+                role: "status"
+                title: "Status"
+                width: 70
             }
         }
 
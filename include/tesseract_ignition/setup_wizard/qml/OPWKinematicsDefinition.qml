@@ -86,6 +86,10 @@ OPWKinematicsDefinitionForm {
                                o1, o2, o3, o4, o5, o6, sc1, sc2, sc3, sc4, sc5, sc6)
     }
 
+    fitOPWKinematicsButton.onClicked: {
+        TesseractSetupWizard.onFitGroupOPWKinematics(opwKinematicsGroupNameComboBox.currentText)
+    }
+
     removeOPWKinematicsButton.onClicked: {
         TesseractSetupWizard.onRemoveGroupOPWKinematics(opwKinematicsTableView.currentRow)
     }
@@ -12,6 +12,7 @@ Item {
     height: 800
     property alias opwKinematicsGroupNameComboBox: opwKinematicsGroupNameComboBox
     property alias addOPWKinematicsButton: addOPWKinematicsButton
+    property alias fitOPWKinematicsButton: fitOPWKinematicsButton
     property alias opwKinematicsTableView: opwKinematicsTableView
     property alias removeOPWKinematicsButton: removeOPWKinematicsButton
     property alias jointCorrectionSwitch5: jointCorrectionSwitch5
@@ -68,8 +69,15 @@ Item {
             id: signCorrectionColumn
             role: "sign_corrections"
             title: "Sign Corrections"
+            width: 125
+        }
+        QC1.TableViewColumn {
+            id: validationColumn
+            role: "validation"
+            title: "Validation"
             width: opwKinematicsTableView.viewport.width - groupNameColumn.width
                    - kinematicParametersColumn.width - offsetColumn.width
+                   - signCorrectionColumn.width
         }
     }
 
@@ -116,6 +124,16 @@ Item {
         anchors.rightMargin: 5
     }
 
+    Button {
+        id: fitOPWKinematicsButton
+        width: 100
+        text: qsTr("Fit")
+        anchors.top: grid.bottom
+        anchors.topMargin: 5
+        anchors.right: addOPWKinematicsButton.left
+        anchors.rightMargin: 5
+    }
+
     GridLayout {
         id: grid
         height: 425
@@ -5,9 +5,42 @@ import QtQuick.Controls 2.2
 import QtQuick.Controls.Material 2.1
 import QtQuick.Layouts 1.3
 import QtQuick.Controls.Styles 1.4
+import QtQuick.Dialogs 1.1
 
 UserDefinedJointStatesForm {
 
+    FileDialog{
+        id: importJointStatesFileDialog;
+        title: "Please choose a joint states file to import";
+        folder: shortcuts.home
+        nameFilters: ["CSV Files (*.csv)"];
+        selectFolder: false
+        selectMultiple: false
+        onAccepted: {
+            console.info("User has selected joint states to import:" + importJointStatesFileDialog.fileUrl);
+            importJointStatesFileDialog.close();
+            TesseractSetupWizard.onImportUserDefinedJointStates(importJointStatesFileDialog.fileUrl.toString());
+        }
+    }
+
+    FileDialog{
+        id: exportJointStatesFileDialog;
+        title: "Please choose a file to export the joint states";
+        folder: shortcuts.home
+        nameFilters: ["CSV Files (*.csv)"];
+        selectFolder: false
+        selectMultiple: false
+        selectExisting: false
+        onAccepted: {
+            console.info("User has selected joint states to export:" + exportJointStatesFileDialog.fileUrl);
+            exportJointStatesFileDialog.close();
+            TesseractSetupWizard.onExportUserDefinedJointStates(exportJointStatesFileDialog.fileUrl.toString());
+        }
+    }
+
+    importUserDefinedJointStatesButton.onClicked: importJointStatesFileDialog.open()
+    exportUserDefinedJointStatesButton.onClicked: exportJointStatesFileDialog.open()
+
     jointGroupListView.delegate: Item {
         id: element1
         width: parent.width
@@ -42,7 +75,7 @@ UserDefinedJointStatesForm {
             }
             Connections {
                 target: slider1
-                onValueChanged: TesseractSetupWizard.onJointValue(model.name, slider1.value)
+                onValueChanged: TesseractSetupWizard.onJointValue(index, slider1.value)
             }
         }
         QC1.SpinBox {
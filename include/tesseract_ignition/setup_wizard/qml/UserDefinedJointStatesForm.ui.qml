@@ -10,6 +10,8 @@ Item {
     id: element
 
     property alias removeUserDefinedJointStateButton: removeUserDefinedJointStateButton
+    property alias importUserDefinedJointStatesButton: importUserDefinedJointStatesButton
+    property alias exportUserDefinedJointStatesButton: exportUserDefinedJointStatesButton
     property alias userDefinedJointStateTableView: userDefinedJointStateTableView
     property alias addUserDefinedJointStateButton: addUserDefinedJointStateButton
     property alias userDefinedJointStateNameTextField: userDefinedJointStateNameTextField
@@ -78,6 +80,26 @@ Item {
             title: "Joint Values"
             width: userDefinedJointStateTableView.viewport.width - groupNameColumn.width
                    - stateNameColumn.width - jointNamesColumn.width
+                   - collisionStatusColumn.width - minDistanceColumn.width
+                   - collisionPairsColumn.width
+        }
+        QC1.TableViewColumn {
+            id: collisionStatusColumn
+            role: "collision_status"
+            title: "Collision"
+            width: 75
+        }
+        QC1.TableViewColumn {
+            id: minDistanceColumn
+            role: "min_distance"
+            title: "Distance"
+            width: 75
+        }
+        QC1.TableViewColumn {
+            id: collisionPairsColumn
+            role: "collision_pairs"
+            title: "Pairs"
+            width: 125
         }
     }
 
@@ -91,6 +113,24 @@ Item {
         anchors.rightMargin: 5
     }
 
+    Button {
+        id: exportUserDefinedJointStatesButton
+        text: qsTr("Export")
+        anchors.bottom: parent.bottom
+        anchors.bottomMargin: 5
+        anchors.right: removeUserDefinedJointStateButton.left
+        anchors.rightMargin: 5
+    }
+
+    Button {
+        id: importUserDefinedJointStatesButton
+        text: qsTr("Import")
+        anchors.bottom: parent.bottom
+        anchors.bottomMargin: 5
+        anchors.right: exportUserDefinedJointStatesButton.left
+        anchors.rightMargin: 5
+    }
+
     Label {
         id: userDefinedGroupNameLabel
         width: 125
@@ -1,4 +1,37 @@
 import QtQuick 2.4
+import QtQuick.Dialogs 1.1
 
 UserDefinedToolCenterPointsForm {
+
+    FileDialog{
+        id: importTCPsFileDialog;
+        title: "Please choose a tool center points file to import";
+        folder: shortcuts.home
+        nameFilters: ["CSV Files (*.csv)"];
+        selectFolder: false
+        selectMultiple: false
+        onAccepted: {
+            console.info("User has selected tool center points to import:" + importTCPsFileDialog.fileUrl);
+            importTCPsFileDialog.close();
+            TesseractSetupWizard.onImportUserDefinedTCPs(importTCPsFileDialog.fileUrl.toString());
+        }
+    }
+
+    FileDialog{
+        id: exportTCPsFileDialog;
+        title: "Please choose a file to export the tool center points";
+        folder: shortcuts.home
+        nameFilters: ["CSV Files (*.csv)"];
+        selectFolder: false
+        selectMultiple: false
+        selectExisting: false
+        onAccepted: {
+            console.info("User has selected tool center points to export:" + exportTCPsFileDialog.fileUrl);
+            exportTCPsFileDialog.close();
+            TesseractSetupWizard.onExportUserDefinedTCPs(exportTCPsFileDialog.fileUrl.toString());
+        }
+    }
+
+    importUserDefinedToolCenterPointsButton.onClicked: importTCPsFileDialog.open()
+    exportUserDefinedToolCenterPointsButton.onClicked: exportTCPsFileDialog.open()
 }
@@ -18,6 +18,8 @@ Item {
     property alias userDefinedOrientationYTextField: userDefinedOrientationYTextField
     property alias addUserDefinedToolCenterPointButton: addUserDefinedToolCenterPointButton
     property alias userDefinedToolCenterPointTableView: userDefinedToolCenterPointTableView
+    property alias importUserDefinedToolCenterPointsButton: importUserDefinedToolCenterPointsButton
+    property alias exportUserDefinedToolCenterPointsButton: exportUserDefinedToolCenterPointsButton
 
     Label {
         id: userDefinedToolCenterPointNameLabel
@@ -94,6 +96,24 @@ Item {
         anchors.rightMargin: 5
     }
 
+    Button {
+        id: exportUserDefinedToolCenterPointsButton
+        text: qsTr("Export")
+        anchors.bottom: parent.bottom
+        anchors.bottomMargin: 5
+        anchors.right: removeUserDefinedToolCenterPointButton.left
+        anchors.rightMargin: 5
+    }
+
+    Button {
+        id: importUserDefinedToolCenterPointsButton
+        text: qsTr("Import")
+        anchors.bottom: parent.bottom
+        anchors.bottomMargin: 5
+        anchors.right: exportUserDefinedToolCenterPointsButton.left
+        anchors.rightMargin: 5
+    }
+
     Label {
         id: userDefinedGroupNameLabel
         width: 125
@@ -142,7 +162,7 @@ Item {
 
     Connections {
         target: removeUserDefinedToolCenterPointButton
-        onClicked: TesseractSetupWizard.onRemoveUserDefinedJointState(
+        onClicked: TesseractSetupWizard.onRemoveUserDefinedTCP(
                        userDefinedToolCenterPointTableView.currentRow)
     }
 
@@ -68,23 +68,57 @@ namespace tesseract_ignition
 
         Q_INVOKABLE void onRemoveKinematicGroup(int index);
 
-        Q_INVOKABLE void onGenerateACM(long resolution);
+        /**
+         * @brief Generate the allowed collision matrix by sampling states
+         * @param resolution The maximum number of samples per link pair
+         * @param sampling_mode The sampling mode, 0 for random and 1 for Halton, see ACMSamplingMode
+         * @param confidence The confidence level used to stop sampling a pair once its class is settled,
+         * zero disables early termination.
+         */
+        Q_INVOKABLE void onGenerateACM(long resolution, int sampling_mode = 0, double confidence = 0.99);
         Q_INVOKABLE void onRemoveACMEntry(int index);
+
+        /** @brief Select the two links of an allowed collision matrix entry in the 3D view */
         Q_INVOKABLE void onClickedACMEntry(int index);
 
+        /** @brief Select a link in the 3D view */
+        Q_INVOKABLE void onClickedLink(const QString &link_name);
+
 
         Q_INVOKABLE void onLoadJointGroup(const QString &group_name);
-        Q_INVOKABLE void onJointValue(const QString &joint_name, double joint_value);
+
+        /**
+         * @brief Set the value of a joint of the loaded joint group
+         *
+         * The value is queued and applied with any other joint changes on the next render update.
+         * @param index The row of the joint in the joint group model
+         * @param joint_value The joint value
+         */
+        Q_INVOKABLE void onJointValue(int index, double joint_value);
 
         Q_INVOKABLE void onAddUserDefinedJointState(const QString &group_name, const QString &state_name);
         Q_INVOKABLE void onRemoveUserDefinedJointState(int index);
 
+        /**
+         * @brief Import user defined joint states from a CSV file
+         * @param filepath The file path or file url
+         */
+        Q_INVOKABLE void onImportUserDefinedJointStates(const QString &filepath);
+        Q_INVOKABLE void onExportUserDefinedJointStates(const QString &filepath);
+
         Q_INVOKABLE void onAddUserDefinedTCP(const QString &group_name,
                                              const QString &tcp_name,
                                              const QVector3D &position,
                                              const QVector3D &orientation);
         Q_INVOKABLE void onRemoveUserDefinedTCP(int index);
 
+        /**
+         * @brief Import user defined tool center points from a CSV file
+         * @param filepath The file path or file url
+         */
+        Q_INVOKABLE void onImportUserDefinedTCPs(const QString &filepath);
+        Q_INVOKABLE void onExportUserDefinedTCPs(const QString &filepath);
+
         Q_INVOKABLE void onAddGroupOPWKinematics(const QString& group_name,
                                                  double a1, double a2, double b,
                                                  double c1, double c2, double c3, double c4,
@@ -92,6 +126,12 @@ namespace tesseract_ignition
                                                  int sc1, int sc2, int sc3, int sc4, int sc5, int sc6);
         Q_INVOKABLE void onRemoveGroupOPWKinematics(int index);
 
+        /**
+         * @brief Fit the OPW kinematic parameters of a group from its kinematic chain
+         * @param group_name The group to fit
+         */
+        Q_INVOKABLE void onFitGroupOPWKinematics(const QString& group_name);
+
       protected:
         Q_INVOKABLE void removeGroupStates(const QString& group_name);
         Q_INVOKABLE void removeGroupTCPs(const QString& group_name);
@@ -21,7 +21,6 @@ import QtQuick.Controls 2.2
 import QtQuick.Controls.Material 2.1
 import QtQuick.Layouts 1.3
 import QtQuick.Controls.Styles 1.4
-import IgnGazebo 1.0 as IgnGazebo
 
 Rectangle {
   id: entityTree
@@ -59,37 +58,120 @@ Rectangle {
    */
   function deselectAllEntities() {
     tree.selection.clear()
+    searchResults.currentIndex = -1
   }
 
   /*
-   * Iterate through item's children until the one corresponding to _entity is
-   * found and select that.
+   * Select entities selected elsewhere, expanding the tree down to them.
    */
-  function selectFromCpp(_entity, itemId) {
-    if (EntityTreeModel.data(itemId, 101) == _entity) {
-      tree.selection.select(itemId, ItemSelectionModel.Select)
-      return
-    }
-    for (var i = 0; i < EntityTreeModel.rowCount(itemId); i++) {
-      selectFromCpp(_entity, EntityTreeModel.index(i, 0, itemId))
+  function selectEntities(_entities) {
+    tree.selection.clear()
+    for (var i = 0; i < _entities.length; ++i) {
+      var idx = TesseractEntityTreeModel.fetchEntityIndex(_entities[i])
+      if (!idx.valid)
+        continue
+
+      var ancestors = []
+      for (var p = TesseractEntityTreeModel.parent(idx); p.valid; p = TesseractEntityTreeModel.parent(p))
+        ancestors.push(p)
+
+      while (ancestors.length > 0)
+        tree.expand(ancestors.pop())
+
+      tree.selection.select(idx, ItemSelectionModel.Select)
     }
   }
 
   /*
-   * Callback when an entity selection comes from the C++ code.
-   * For example, if it comes from the 3D window.
+   * Send the entities selected in the tree.
    */
-  function onEntitySelectedFromCpp(_entity) {
-    for(var i = 0; i < EntityTreeModel.rowCount(); i++) {
-      var itemId = EntityTreeModel.index(i, 0)
-      selectFromCpp(_entity, itemId)
+  function sendTreeSelection() {
+    var entities = []
+    var indexes = tree.selection.selectedIndexes
+    for (var i = 0; i < indexes.length; ++i)
+      entities.push(TesseractEntityTreeModel.entity(indexes[i]))
+
+    TesseractEntityTree.OnEntitiesSelectedFromQml(entities)
+  }
+
+  TextField {
+    id: searchField
+    anchors.top: parent.top
+    anchors.left: parent.left
+    anchors.right: parent.right
+    placeholderText: "Search links, joints and visuals"
+    selectByMouse: true
+    onTextChanged: TesseractEntitySearchModel.search(text)
+  }
+
+  ListView {
+    id: searchResults
+    visible: searchField.text.trim() !== ""
+    anchors.top: searchField.bottom
+    anchors.bottom: parent.bottom
+    anchors.left: parent.left
+    anchors.right: parent.right
+    clip: true
+    currentIndex: -1
+    model: TesseractEntitySearchModel
+    ScrollBar.vertical: ScrollBar {}
+
+    delegate: Rectangle {
+      id: resultDel
+      width: searchResults.width
+      height: itemHeight
+      color: ListView.isCurrentItem ? Material.accent : (index % 2 == 0) ? even : odd
+
+      Text {
+        id: resultType
+        anchors.verticalCenter: parent.verticalCenter
+        width: itemHeight
+        horizontalAlignment: Text.AlignHCenter
+        text: model.type.charAt(0).toUpperCase()
+        color: Material.theme == Material.Light ? "black" : "white"
+        font.pointSize: 10
+        font.bold: true
+      }
+
+      Text {
+        anchors.verticalCenter: parent.verticalCenter
+        anchors.left: resultType.right
+        leftPadding: 2
+        text: model.name
+        color: Material.theme == Material.Light ? "black" : "white"
+        font.pointSize: 12
+        font.italic: !model.exact
+      }
+
+      ToolTip {
+        visible: resultMa.containsMouse
+        delay: tooltipDelay
+        text: model.scopedName + "\n" + model.type + (model.entity > 0 ? ", Entity Id: " + model.entity : "")
+        y: resultDel.z - 30
+        enter: null
+        exit: null
+      }
+
+      MouseArea {
+        id: resultMa
+        anchors.fill: parent
+        hoverEnabled: true
+        onClicked: {
+          searchResults.currentIndex = index
+          TesseractEntityTree.OnEntitiesSelectedFromQml([model.entity])
+        }
+      }
     }
   }
 
   TreeView {
     id: tree
-    anchors.fill: parent
-    model: EntityTreeModel
+    visible: !searchResults.visible
+    anchors.top: searchField.bottom
+    anchors.bottom: parent.bottom
+    anchors.left: parent.left
+    anchors.right: parent.right
+    model: TesseractEntityTreeModel
     selectionMode: SelectionMode.MultiSelection
 
     // Hacky: the sibling of listView is the background(Rectangle) of TreeView
@@ -101,7 +183,7 @@ Rectangle {
     }
 
     selection: ItemSelectionModel {
-      model: EntityTreeModel
+      model: TesseractEntityTreeModel
     }
 
     style: TreeViewStyle {
@@ -115,15 +197,12 @@ Rectangle {
         height: itemHeight
         width: itemHeight * 0.75
         color: "transparent"
-        Image {
-          id: icon
-          sourceSize.height: itemHeight * 0.4
-          sourceSize.width: itemHeight * 0.4
-          fillMode: Image.Pad
+        Text {
           anchors.verticalCenter: parent.verticalCenter
           anchors.right: parent.right
-          source: styleData.isExpanded ?
-              "qrc:/Gazebo/images/minus.png" : "qrc:/Gazebo/images/plus.png"
+          text: styleData.isExpanded ? "\u2212" : "+"
+          color: Material.theme == Material.Light ? "black" : "white"
+          font.pointSize: 12
         }
         MouseArea {
           anchors.fill: parent
@@ -134,6 +213,7 @@ Rectangle {
             // behaviour gets messy otherwise.
             mouse.accepted = true
 
+            // Expanding asks the model to create the children of the node
             if (tree.isExpanded(styleData.index))
               tree.collapse(styleData.index)
             else
@@ -153,11 +233,6 @@ Rectangle {
           onClicked: {
             // Stop event propagation and handle selection here.
             mouse.accepted = true
-
-            // branchDelegate and itemDelegate have styleData.index, but, for
-            // some reason, rowDelegate doesn't. So instead of finding
-            // the QModelIndex some other way we just disable selection from the
-            // row for now
           }
         }
       }
@@ -167,35 +242,22 @@ Rectangle {
         color: styleData.selected ? Material.accent : (styleData.row % 2 == 0) ? even : odd
         height: itemHeight
 
-        Image {
-          id: icon
-          sourceSize.height: itemHeight
-          sourceSize.width: itemHeight
-          fillMode: Image.PreserveAspectFit
-          horizontalAlignment: Image.AlignHCenter
-          verticalAlignment: Image.AlignLeft
-          source: model === null || model.icon === undefined ? "" : model.icon
-
-          ToolTip {
-            visible: iconMa.containsMouse
-            delay: tooltipDelay
-            text: model === null || model.type === undefined ? "" : model.type
-            y: icon.z - 30
-            enter: null
-            exit: null
-          }
-          MouseArea {
-            id: iconMa
-            anchors.fill: parent
-            hoverEnabled: true
-          }
+        Text {
+          id: typeLabel
+          anchors.verticalCenter: parent.verticalCenter
+          width: itemHeight
+          horizontalAlignment: Text.AlignHCenter
+          text: model === null || model.type === undefined ? "" : model.type.charAt(0).toUpperCase()
+          color: Material.theme == Material.Light ? "black" : "white"
+          font.pointSize: 10
+          font.bold: true
         }
 
         Text {
           anchors.verticalCenter: parent.verticalCenter
-          anchors.left: icon.right
+          anchors.left: typeLabel.right
           leftPadding: 2
-          text: model === null || model.entityName === undefined ? "" : model.entityName
+          text: model === null || model.name === undefined ? "" : model.name
           color: Material.theme == Material.Light ? "black" : "white"
           font.pointSize: 12
         }
@@ -203,8 +265,9 @@ Rectangle {
         ToolTip {
           visible: ma.containsMouse
           delay: tooltipDelay
-          text: model === null || model.entity === undefined ?
-              "Entity Id: ?" : "Entity Id: " + model.entity
+          text: model === null || model.type === undefined ? "" :
+              TesseractEntityTreeModel.scopedName(styleData.index) + "\n" +
+              model.type + (model.entity > 0 ? ", Entity Id: " + model.entity : "")
           y: itemDel.z - 30
           enter: null
           exit: null
@@ -215,35 +278,20 @@ Rectangle {
           anchors.fill: parent
           hoverEnabled: true
           propagateComposedEvents: true
-          acceptedButtons: Qt.RightButton | Qt.LeftButton
+          acceptedButtons: Qt.LeftButton
           onClicked: {
             mouse.accepted = false
-            if (mouse.button == Qt.RightButton) {
-              var type = EntityTreeModel.EntityType(styleData.index)
-              var scopedName = EntityTreeModel.ScopedName(styleData.index)
-              entityContextMenu.open(scopedName, type, ma.mouseX, ma.mouseY)
-              // Prevent plugin's context menu from opening
-              mouse.accepted = true
-            }
-            else if (mouse.button == Qt.LeftButton) {
-              var mode = mouse.modifiers & Qt.ControlModifier ?
-                  ItemSelectionModel.Select : ItemSelectionModel.ClearAndSelect
-              var entity = EntityTreeModel.EntityId(styleData.index)
-              EntityTree.OnEntitySelectedFromQml(entity)
-              tree.selection.select(styleData.index, mode)
-            }
+            var mode = mouse.modifiers & Qt.ControlModifier ?
+                ItemSelectionModel.Select : ItemSelectionModel.ClearAndSelect
+            tree.selection.select(styleData.index, mode)
+            sendTreeSelection()
           }
         }
       }
     }
 
-    IgnGazebo.EntityContextMenu {
-      id: entityContextMenu
-      anchors.fill: ma
-    }
-
     TableViewColumn {
-      role: "entityName"
+      role: "name"
       width: parent.width
     }
   }
@@ -0,0 +1,119 @@
+/**
+ * @file scene_graph_search_index.h
+ * @brief A trigram index for searching the links, joints and visuals of a scene graph by scoped name
+ *
+ * @author Levi Armstrong
+ * @date October 18, 2026
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @copyright Copyright (c) 2020, Southwest Research Institute
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TESSERACT_IGNITION_SCENE_GRAPH_SEARCH_INDEX_H
+#define TESSERACT_IGNITION_SCENE_GRAPH_SEARCH_INDEX_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <tesseract_scene_graph/graph.h>
+#include <tesseract_visualization/ignition/entity_manager.h>
+#include <tesseract_ignition/tree/scene_graph_tree_model.h>
+
+namespace tesseract_ignition
+{
+
+/** @brief A searchable element of the scene graph */
+struct SceneGraphSearchEntry
+{
+  SceneGraphTreeNodeType type {SceneGraphTreeNodeType::LINK};
+  std::string name;
+
+  /** @brief The index of the entry of the parent in the tree, the root link is its own parent */
+  std::size_t parent {0};
+
+  /** @brief The rendering entity of a link or visual, zero for joints */
+  tesseract_visualization::EntityID entity {0};
+};
+
+/** @brief A match of a search query */
+struct SceneGraphSearchResult
+{
+  /** @brief The index of the matching entry, see SceneGraphSearchIndex::getEntry */
+  std::size_t entry {0};
+
+  /** @brief True if the query is a substring of the name, false for a fuzzy match */
+  bool exact {false};
+
+  /** @brief Higher is better, results are sorted by it */
+  double score {0};
+};
+
+/**
+ * @brief An index of the names of every link, joint and visual of a scene graph
+ *
+ * Every three character sequence of the lower case names is mapped to the entries containing it. A query of three or
+ * more characters only checks the entries which contain all of its trigrams for a substring match, and ranks the
+ * entries sharing at least half of its trigrams as fuzzy matches, so the cost follows the number of candidates rather
+ * than the size of the scene graph. Shorter queries scan the names, which is cheap for so few characters.
+ *
+ * Only the names are matched, matching the scoped names would return every descendant of a matching link. Each entry
+ * keeps the index of its parent so the scoped name of a result is built without the tree.
+ */
+class SceneGraphSearchIndex
+{
+public:
+  /**
+   * @brief Build the index
+   * @param scene_graph The scene graph to index, starting at its root link
+   * @param entity_manager The entity manager the scene graph was rendered with, used to look up entity ids
+   */
+  SceneGraphSearchIndex(const tesseract_scene_graph::SceneGraph& scene_graph,
+                        const tesseract_visualization::EntityManager& entity_manager);
+
+  /**
+   * @brief Search the names, the match is case insensitive
+   * @param query The text to search for
+   * @param max_results The maximum number of results returned
+   * @return The substring matches followed by the fuzzy matches, best first
+   */
+  std::vector<SceneGraphSearchResult> search(const std::string& query, std::size_t max_results) const;
+
+  const SceneGraphSearchEntry& getEntry(std::size_t index) const;
+
+  /** @brief Get the names from the root to the entry joined by "::", as shown by the tree */
+  std::string getScopedName(std::size_t index) const;
+
+  std::size_t size() const;
+
+private:
+  std::vector<SceneGraphSearchEntry> entries_;
+
+  /** @brief The lower case name of each entry */
+  std::vector<std::string> keys_;
+
+  /** @brief The entries containing each trigram, in ascending order */
+  std::unordered_map<std::uint32_t, std::vector<std::uint32_t>> trigrams_;
+
+  /** @brief Add an entry and return its index */
+  std::size_t addEntry(SceneGraphSearchEntry entry);
+};
+
+}
+
+#endif // TESSERACT_IGNITION_SCENE_GRAPH_SEARCH_INDEX_H
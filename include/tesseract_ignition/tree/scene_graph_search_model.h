@@ -0,0 +1,93 @@
+/**
+ * @file scene_graph_search_model.h
+ * @brief A Qt List Model of the links, joints and visuals of a scene graph matching a search query
+ *
+ * @author Levi Armstrong
+ * @date October 18, 2026
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @copyright Copyright (c) 2020, Southwest Research Institute
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TESSERACT_IGNITION_SCENE_GRAPH_SEARCH_MODEL_H
+#define TESSERACT_IGNITION_SCENE_GRAPH_SEARCH_MODEL_H
+
+#ifndef Q_MOC_RUN
+#include <tesseract_ignition/tree/scene_graph_search_index.h>
+#include <QAbstractListModel>
+#include <memory>
+#include <vector>
+#endif
+
+namespace tesseract_ignition
+{
+
+/**
+ * @brief A list model of the search results over a scene graph
+ *
+ * The search index is built the first time a query is made after the scene graph is set, so loading an environment
+ * does not pay for it unless the user searches.
+ */
+class SceneGraphSearchModel : public QAbstractListModel
+{
+  Q_OBJECT
+public:
+
+  enum SceneGraphSearchRoles {
+      NameRole = Qt::UserRole + 1,
+      ScopedNameRole = Qt::UserRole + 2,
+      EntityRole = Qt::UserRole + 3,
+      TypeRole = Qt::UserRole + 4,
+      ExactRole = Qt::UserRole + 5
+  };
+
+  SceneGraphSearchModel(QObject *parent = nullptr);
+  ~SceneGraphSearchModel() override = default;
+
+  /**
+   * @brief Set the scene graph to search, this clears the results
+   * @param scene_graph The scene graph, nullptr clears the model
+   * @param entity_manager The entity manager the scene graph was rendered with, used to look up entity ids
+   */
+  void setSceneGraph(tesseract_scene_graph::SceneGraph::ConstPtr scene_graph,
+                     const tesseract_visualization::EntityManager& entity_manager);
+
+  Q_INVOKABLE void clear();
+
+  /** @brief Replace the results with the matches of a query, an empty query clears them */
+  Q_INVOKABLE void search(const QString& query);
+
+  int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+  QHash<int, QByteArray> roleNames() const override;
+
+private:
+  tesseract_scene_graph::SceneGraph::ConstPtr scene_graph_;
+  std::unique_ptr<tesseract_visualization::EntityManager> entity_manager_;
+
+  /** @brief The index of the scene graph, nullptr until the first query */
+  std::unique_ptr<SceneGraphSearchIndex> index_;
+
+  std::vector<SceneGraphSearchResult> results_;
+
+  /** @brief The maximum number of results shown */
+  std::size_t max_results_ {200};
+};
+
+}
+
+#endif // TESSERACT_IGNITION_SCENE_GRAPH_SEARCH_MODEL_H
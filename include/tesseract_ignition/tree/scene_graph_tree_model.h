@@ -0,0 +1,187 @@
+/**
+ * @file scene_graph_tree_model.h
+ * @brief A Qt Tree Model of the links, joints and visuals of a scene graph
+ *
+ * @author Levi Armstrong
+ * @date October 18, 2026
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @copyright Copyright (c) 2020, Southwest Research Institute
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TESSERACT_IGNITION_SCENE_GRAPH_TREE_MODEL_H
+#define TESSERACT_IGNITION_SCENE_GRAPH_TREE_MODEL_H
+
+#ifndef Q_MOC_RUN
+#include <tesseract_scene_graph/graph.h>
+#include <tesseract_visualization/ignition/entity_manager.h>
+#include <QAbstractItemModel>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#endif
+
+namespace tesseract_ignition
+{
+
+/** @brief The kind of scene graph element a tree node represents */
+enum class SceneGraphTreeNodeType
+{
+  LINK,
+  JOINT,
+  VISUAL
+};
+
+/** @brief Get the name of a node type shown to the user, "link", "joint" or "visual" */
+QString toQString(SceneGraphTreeNodeType type);
+
+/** @brief A node of the scene graph tree, its children are only created once the node is expanded */
+struct SceneGraphTreeNode
+{
+  SceneGraphTreeNodeType type {SceneGraphTreeNodeType::LINK};
+  std::string name;
+
+  /** @brief The rendering entity of a link or visual, zero for joints */
+  tesseract_visualization::EntityID entity {0};
+
+  SceneGraphTreeNode* parent {nullptr};
+
+  /** @brief The row of this node under its parent */
+  int row {0};
+
+  /** @brief The children which have not been created yet, released once they are */
+  std::vector<std::pair<SceneGraphTreeNodeType, std::string>> pending;
+
+  std::vector<std::unique_ptr<SceneGraphTreeNode>> children;
+};
+
+/**
+ * @brief A tree model of a scene graph, starting at the root link
+ *
+ * A link's children are its visuals followed by its child joints, and a joint's only child is its child link. Only
+ * the root link is created when the scene graph is set. The children of a node are created the first time a view
+ * expands it and are inserted as one batch, so the cost of the model follows what the user has opened rather than
+ * the size of the scene graph.
+ *
+ * The scene graph is read while nodes are created. Links removed from it must also be passed to removeLinks, and the
+ * scene graph must be set again after the environment is reloaded. The created joint nodes are indexed by child link
+ * and the link and visual nodes by entity id, so finding the row of a link or entity does not search the tree.
+ */
+class SceneGraphTreeModel : public QAbstractItemModel
+{
+  Q_OBJECT
+public:
+
+  enum SceneGraphTreeRoles {
+      NameRole = Qt::UserRole + 1,
+      EntityRole = Qt::UserRole + 2,
+      TypeRole = Qt::UserRole + 3
+  };
+  Q_ENUM(SceneGraphTreeRoles)
+
+  SceneGraphTreeModel(QObject *parent = nullptr);
+  ~SceneGraphTreeModel() override = default;
+
+  /**
+   * @brief Set the scene graph to display, this resets the model
+   * @param scene_graph The scene graph, nullptr clears the model
+   * @param entity_manager The entity manager the scene graph was rendered with, used to look up entity ids
+   */
+  void setSceneGraph(tesseract_scene_graph::SceneGraph::ConstPtr scene_graph,
+                     const tesseract_visualization::EntityManager& entity_manager);
+
+  Q_INVOKABLE void clear();
+
+  /**
+   * @brief Remove links and everything below them
+   *
+   * This is for links which have already been removed from the scene graph. A removed link is removed together with
+   * the joint connecting it to its parent. Links below another removed link are dropped with it, and the remaining
+   * subtrees are removed with one beginRemoveRows per contiguous range of rows under each parent. Links whose joint
+   * has not been created yet need no work, they are skipped when their parent is expanded.
+   */
+  void removeLinks(const std::vector<std::string>& link_names);
+
+  /** @brief Get the names from the root to the node joined by "::" */
+  Q_INVOKABLE QString scopedName(const QModelIndex &index) const;
+
+  /** @brief Get the entity id of a node, 0 for joints and invalid indexes */
+  Q_INVOKABLE unsigned entity(const QModelIndex &index) const;
+
+  /** @brief Get the index of the node of an entity, invalid if the node has not been created yet */
+  Q_INVOKABLE QModelIndex entityIndex(unsigned entity) const;
+
+  /**
+   * @brief Get the index of the node of an entity, creating the nodes on the path from the root to it
+   *
+   * Only the nodes on the path are fetched, the rest of the tree is left as it is.
+   * @return The index of the node, invalid if the entity is not a link or visual of the scene graph
+   */
+  Q_INVOKABLE QModelIndex fetchEntityIndex(unsigned entity);
+
+  QModelIndex index(int row, int column, const QModelIndex &parent = QModelIndex()) const override;
+  QModelIndex parent(const QModelIndex &index) const override;
+  int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+  int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+  bool hasChildren(const QModelIndex &parent = QModelIndex()) const override;
+  bool canFetchMore(const QModelIndex &parent) const override;
+  void fetchMore(const QModelIndex &parent) override;
+  QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+  QHash<int, QByteArray> roleNames() const override;
+
+private:
+  tesseract_scene_graph::SceneGraph::ConstPtr scene_graph_;
+  std::unordered_map<std::string, tesseract_visualization::EntityID> link_entities_;
+  std::unordered_map<std::string, tesseract_visualization::EntityID> visual_entities_;
+
+  /** @brief The root link node, nullptr if there is no scene graph */
+  std::unique_ptr<SceneGraphTreeNode> root_;
+
+  /** @brief The created joint nodes by the name of their child link */
+  std::unordered_map<std::string, SceneGraphTreeNode*> joint_nodes_;
+
+  /** @brief The created link and visual nodes by entity id */
+  std::unordered_map<tesseract_visualization::EntityID, SceneGraphTreeNode*> entity_nodes_;
+
+  /** @brief The link of every link and visual entity, built by the first fetchEntityIndex */
+  std::unordered_map<tesseract_visualization::EntityID, std::string> entity_links_;
+
+  /** @brief Create a node and record the children it will have, without creating them */
+  std::unique_ptr<SceneGraphTreeNode> createNode(SceneGraphTreeNodeType type, const std::string& name) const;
+
+  /** @brief Check if the scene graph still has the element a pending child was recorded for */
+  bool exists(SceneGraphTreeNodeType type, const std::string& name) const;
+
+  /** @brief Add a created node to the joint and entity indexes */
+  void addToIndex(SceneGraphTreeNode* node);
+
+  /** @brief Remove a node and all of its created descendants from the joint and entity indexes */
+  void removeFromIndex(const SceneGraphTreeNode* node);
+
+  /** @brief Remove the rows [first, last] of a node and renumber the following children */
+  void removeChildren(SceneGraphTreeNode* node, int first, int last);
+
+  SceneGraphTreeNode* getNode(const QModelIndex &index) const;
+
+  QModelIndex getIndex(SceneGraphTreeNode* node) const;
+};
+
+}
+
+#endif // TESSERACT_IGNITION_SCENE_GRAPH_TREE_MODEL_H
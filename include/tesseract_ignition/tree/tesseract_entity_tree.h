@@ -14,93 +14,50 @@
  * limitations under the License.
  *
 */
+#ifndef TESSERACT_IGNITION_TESSERACT_ENTITY_TREE_H
+#define TESSERACT_IGNITION_TESSERACT_ENTITY_TREE_H
 
-#ifndef IGNITION_GAZEBO_GUI_ENTITYTREE_HH_
-#define IGNITION_GAZEBO_GUI_ENTITYTREE_HH_
-
-#include <map>
 #include <memory>
 
-#include <ignition/gazebo/gui/GuiSystem.hh>
+#include <ignition/gui/Plugin.hh>
 
-namespace ignition
+namespace tesseract_ignition
 {
-namespace gazebo
+namespace gui
 {
-  class EntityTreePrivate;
-
-  /// \brief TODO
-  class TreeModel : public QStandardItemModel
-  {
-    Q_OBJECT
-
-    /// \brief Constructor
-    public: explicit TreeModel();
-
-    /// \brief Destructor
-    public: ~TreeModel() override = default;
-
-    // Documentation inherited
-    public: QHash<int, QByteArray> roleNames() const override;
-
-    /// \brief Add an entity to the tree.
-    /// \param[in] _entity Entity to be added
-    /// \param[in] _entityName Name of entity to be added
-    /// \param[in] _parentEntity Parent entity. By default, kNullEntity, which
-    /// means it's a root entity.
-    /// \param[in] _type Entity type
-    public slots: void AddEntity(unsigned int _entity,
-        const QString &_entityName,
-        unsigned int _parentEntity = kNullEntity,
-        const QString &_type = QString());
-
-    /// \brief Remove an entity from the tree.
-    /// \param[in] _entity Entity to be removed
-    public slots: void RemoveEntity(unsigned int _entity);
-
-    /// \brief Get the entity type of a tree item at specified index
-    /// \param[in] _index Model index
-    /// \return Type of entity
-    public: Q_INVOKABLE QString EntityType(const QModelIndex &_index) const;
-
-    /// \brief Get the scoped name of a tree item at specified index
-    /// \param[in] _index Model index
-    /// \return Scoped name of the entity
-    public: Q_INVOKABLE QString ScopedName(const QModelIndex &_index) const;
-
-    /// \brief Get the entity ID of a tree item at specified index
-    /// \param[in] _index Model index
-    /// \return Entity ID
-    public: Q_INVOKABLE unsigned int EntityId(const QModelIndex &_index) const;
-
-    /// \brief Keep track of which item corresponds to which entity.
-    private: std::map<Entity, QStandardItem *> entityItems;
-  };
+namespace plugins
+{
+  class TesseractEntityTreePrivate;
 
-  /// \brief Displays a tree view with all the entities in the world.
+  /// \brief Displays a tree view with the links, joints and visuals of the
+  /// environment loaded into the scene.
+  ///
+  /// The tree is rebuilt when a SceneGraphLoaded event is received, only the
+  /// root link is created up front and the rest is created as it is expanded.
+  /// Selecting an entity in the tree sends an EntitiesSelected event, and
+  /// entities selected elsewhere are expanded to and selected in the tree.
   ///
   /// ## Configuration
   /// None
-  class EntityTree : public ignition::gazebo::GuiSystem
+  class TesseractEntityTree : public ignition::gui::Plugin
   {
     Q_OBJECT
 
     /// \brief Constructor
-    public: EntityTree();
+    public: TesseractEntityTree();
 
     /// \brief Destructor
-    public: ~EntityTree() override;
+    public: ~TesseractEntityTree() override;
 
     // Documentation inherited
     public: void LoadConfig(const tinyxml2::XMLElement *_pluginElem) override;
 
-    // Documentation inherited
-    public: void Update(const UpdateInfo &, EntityComponentManager &) override;
-
-    /// \brief Callback when an entity has been selected. This should be
-    /// called from QML.
-    /// \param[in] _entity Entity being selected.
-    public: Q_INVOKABLE void OnEntitySelectedFromQml(unsigned int _entity);
+    /// \brief Callback in Qt thread when entities are selected in the tree.
+    /// This should be called from QML.
+    /// \param[in] _entities The entities selected, an empty list deselects
+    /// all entities.
+    public: Q_INVOKABLE void OnEntitiesSelectedFromQml(
+        const QVariantList &_entities);
 
     /// \brief Callback when all entities have been deselected.
     /// This should be called from QML.
@@ -111,9 +68,10 @@ namespace gazebo
 
     /// \internal
     /// \brief Pointer to private data.
-    private: std::unique_ptr<EntityTreePrivate> dataPtr;
+    private: std::unique_ptr<TesseractEntityTreePrivate> dataPtr;
   };
 }
 }
+}
 
-#endif
+#endif // TESSERACT_IGNITION_TESSERACT_ENTITY_TREE_H
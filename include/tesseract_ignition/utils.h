@@ -6,8 +6,18 @@
 namespace tesseract_ignition
 {
 
+/**
+ * @brief Get the local file path of a package:// or file:// url
+ *
+ * The results are cached, including the urls which could not be resolved so their error is only logged once. The
+ * cache is cleared when TSW_RESOURCE_PATH or ROS_PACKAGE_PATH changes. This is safe to call from any thread.
+ * @return The local file path, empty if it could not be resolved
+ */
 std::string locateResource(const std::string& url);
 
+/** @brief Clear the cached urls and packages, for when the package directories have changed on disk */
+void clearResourceCache();
+
 }
 
 #endif // TESSERACT_IGNITION_UTILS_H
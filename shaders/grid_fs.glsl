@@ -0,0 +1,56 @@
+#version 130
+
+// Fragment shader of the adaptive grid
+//
+// The lines are computed from the world position of each fragment, so the grid has no geometry to rebuild. The
+// spacing goes up by a factor of ten once the cells get too small on screen, and the finer level fades out before it
+// is dropped so the levels do not pop while zooming.
+
+in vec2 world_pos;
+
+// The spacing of the finest lines, in meters
+uniform float cell_length;
+
+uniform vec4 color;
+
+// The height of the plane
+uniform float height;
+
+uniform vec3 camera_position;
+
+// The lines are faded out completely at this distance from the camera
+uniform float fade_distance;
+
+out vec4 frag_color;
+
+// The minimum width of a cell on screen, in pixels
+const float min_cell_pixels = 8.0;
+
+// Coverage of the lines of a grid with the given spacing, about one pixel wide at any distance
+float gridLines(vec2 pos, float spacing)
+{
+  vec2 coord = pos / spacing;
+  vec2 width = fwidth(coord);
+  vec2 dist = abs(fract(coord - 0.5) - 0.5) / width;
+  return 1.0 - min(min(dist.x, dist.y), 1.0);
+}
+
+void main()
+{
+  vec2 footprint = fwidth(world_pos);
+  float pixel_size = max(footprint.x, footprint.y);
+  float lod = max(0.0, log(pixel_size * min_cell_pixels / cell_length) / log(10.0));
+  float level = floor(lod);
+  float blend = fract(lod);
+
+  float spacing = cell_length * pow(10.0, level);
+  float alpha = max(gridLines(world_pos, spacing) * (1.0 - blend), gridLines(world_pos, spacing * 10.0));
+
+  float dist = distance(camera_position, vec3(world_pos, height));
+  alpha *= 1.0 - smoothstep(0.5 * fade_distance, fade_distance, dist);
+
+  if (alpha * color.a < 0.01)
+    discard;
+
+  frag_color = vec4(color.rgb, color.a * alpha);
+}
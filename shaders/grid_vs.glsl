@@ -0,0 +1,20 @@
+#version 130
+
+// Vertex shader of the adaptive grid, drawn on a horizontal plane centred under the camera
+
+in vec4 vertex;
+
+uniform mat4 worldviewproj_matrix;
+
+// The world position of the centre of the plane and its width, the plane is not rotated
+uniform float center_x;
+uniform float center_y;
+uniform float size;
+
+out vec2 world_pos;
+
+void main()
+{
+  gl_Position = worldviewproj_matrix * vertex;
+  world_pos = vec2(center_x, center_y) + vertex.xy * size;
+}
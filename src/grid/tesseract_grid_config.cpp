@@ -15,16 +15,22 @@
  *
 */
 
+#include <mutex>
+#include <string>
+
 #include <ignition/common/Console.hh>
+#include <ignition/common/Filesystem.hh>
 #include <ignition/gui/Application.hh>
 #include <ignition/gui/MainWindow.hh>
 #include <ignition/plugin/Register.hh>
 #include <ignition/math/Color.hh>
+#include <ignition/math/Helpers.hh>
 #include <ignition/math/Pose3.hh>
 #include <ignition/rendering.hh>
 
 #include <tesseract_ignition/gui_events.h>
 #include <tesseract_ignition/grid/tesseract_grid_config.h>
+#include <tesseract_ignition/grid/grid_utils.h>
 
 namespace tesseract_ignition::gui::plugins
 {
@@ -47,6 +53,20 @@ namespace tesseract_ignition::gui::plugins
 
     /// \brief Default visible state
     bool visible{true};
+
+    /// \brief Draw the adaptive shader grid instead of the line grid
+    bool shader{false};
+  };
+
+  /// \brief The grid parameters which changed since they were last applied
+  enum GridDirty : unsigned
+  {
+    GRID_DIRTY_NONE = 0,
+    GRID_DIRTY_CELLS = 1u << 0,
+    GRID_DIRTY_POSE = 1u << 1,
+    GRID_DIRTY_COLOR = 1u << 2,
+    GRID_DIRTY_VISIBLE = 1u << 3,
+    GRID_DIRTY_MODE = 1u << 4
   };
 
   class TesseractGridConfigPrivate
@@ -54,11 +74,66 @@ namespace tesseract_ignition::gui::plugins
     /// \brief Assume only one gridptr in a scene
     public: ignition::rendering::GridPtr grid;
 
+    /// \brief The id of the registered grid visual the grid was found with,
+    /// a different id means the grid was recreated
+    public: unsigned gridVisualId{0};
+
+    /// \brief The scene of the grid
+    public: ignition::rendering::ScenePtr scene;
+
+    /// \brief Plane drawn by the grid shaders, null until the shader grid is
+    /// first shown
+    public: ignition::rendering::VisualPtr shaderGrid;
+
+    /// \brief The camera the shader grid is centred under
+    public: ignition::rendering::CameraPtr camera;
+
+    /// \brief The camera position the shader grid was last centred on
+    public: ignition::math::Vector3d shaderGridCamera;
+
+    /// \brief True if the grid shaders could not be loaded
+    public: bool shaderFailed{false};
+
     /// \brief Default grid parameters
     public: GridParam gridParam;
 
-    /// \brief Flag that indicates whether there are new updates to be rendered.
-    public: bool dirty{false};
+    /// \brief The GridDirty flags of the parameters to apply on the next
+    /// render event, cleared once they are applied.
+    public: unsigned dirty{GRID_DIRTY_NONE};
+
+    /// \brief The GridDirty flags of every parameter set since the plugin
+    /// started, reapplied if the grid is recreated.
+    public: unsigned changed{GRID_DIRTY_NONE};
+
+    /// \brief Protects gridParam and dirty, which are set from the Qt thread
+    /// and applied in the render thread.
+    public: std::mutex mutex;
+
+    /// \brief Set a parameter and mark it dirty if the value changed
+    /// \param[in] _param The parameter to set
+    /// \param[in] _value The new value
+    /// \param[in] _flag The GridDirty flag of the parameter
+    public: template <typename T>
+    void Set(T &_param, const T &_value, GridDirty _flag)
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      if (_param == _value)
+        return;
+
+      _param = _value;
+      this->dirty |= _flag;
+      this->changed |= _flag;
+    }
+
+    /// \brief Create the shader grid plane and its material
+    /// \return False if the shaders could not be loaded
+    public: bool LoadShaderGrid();
+
+    /// \brief Apply the parameters to the shader grid and centre it under
+    /// the camera, if the camera moved or a parameter changed
+    /// \param[in] _gridParam The grid parameters
+    /// \param[in] _dirty The GridDirty flags of the changed parameters
+    public: void UpdateShaderGrid(const GridParam &_gridParam, unsigned _dirty);
   };
 }
 
@@ -76,11 +151,29 @@ TesseractGridConfig::TesseractGridConfig()
 TesseractGridConfig::~TesseractGridConfig() = default;
 
 /////////////////////////////////////////////////
-void TesseractGridConfig::LoadConfig(const tinyxml2::XMLElement *)
+void TesseractGridConfig::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 {
   if (this->title.empty())
     this->title = "Tesseract Grid Config";
 
+  if (_pluginElem)
+  {
+    if (auto elem = _pluginElem->FirstChildElement("mode"))
+    {
+      std::string mode = elem->GetText();
+      if (mode == "shader")
+      {
+        this->OnShaderMode(true);
+        this->PluginItem()->setProperty("shaderMode", true);
+      }
+      else if (mode != "lines")
+      {
+        ignerr << "Unknown grid mode [" << mode << "], expected lines or "
+               << "shader" << std::endl;
+      }
+    }
+  }
+
   ignition::gui::App()->findChild<ignition::gui::MainWindow *>()->installEventFilter(this);
 }
 
@@ -101,6 +194,23 @@ bool TesseractGridConfig::eventFilter(QObject *_obj, QEvent *_event)
 /////////////////////////////////////////////////
 void TesseractGridConfig::UpdateGrid()
 {
+  // The render utils recreate and register the grid when an environment is
+  // loaded, so check the registered grid is still the one attached to and
+  // reapply the parameters set by the user to a new one. Only the id is read
+  // every frame, the grid is looked up when it changes.
+  if (nullptr != this->dataPtr->grid)
+  {
+    unsigned gridVisualId = getGridVisualId(this->dataPtr->scene);
+    if (gridVisualId != this->dataPtr->gridVisualId)
+    {
+      igndbg << "Grid was recreated, attaching to the new grid" << std::endl;
+      this->dataPtr->grid = findGrid(this->dataPtr->scene);
+      this->dataPtr->gridVisualId = gridVisualId;
+      std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+      this->dataPtr->dirty |= this->dataPtr->changed;
+    }
+  }
+
   if (nullptr == this->dataPtr->grid)
   {
     this->LoadGrid();
@@ -111,27 +221,182 @@ void TesseractGridConfig::UpdateGrid()
     return;
   }
 
-  if (!this->dataPtr->dirty)
-    return;
+  // Take the changes made since the last render event, so nothing is pushed
+  // to the grid while the parameters stay the same
+  GridParam gridParam;
+  unsigned dirty{GRID_DIRTY_NONE};
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
-  this->dataPtr->grid->SetVerticalCellCount(static_cast<unsigned>(this->dataPtr->gridParam.vCellCount));
-  this->dataPtr->grid->SetCellCount(static_cast<unsigned>(this->dataPtr->gridParam.hCellCount));
-  this->dataPtr->grid->SetCellLength(this->dataPtr->gridParam.cellLength);
+    // The shader grid follows the camera, so it is checked every frame
+    if (this->dataPtr->dirty == GRID_DIRTY_NONE &&
+        (!this->dataPtr->gridParam.shader || this->dataPtr->shaderFailed))
+      return;
+
+    gridParam = this->dataPtr->gridParam;
+    dirty = this->dataPtr->dirty;
+    this->dataPtr->dirty = GRID_DIRTY_NONE;
+  }
+
+  if (gridParam.shader && !this->dataPtr->shaderGrid &&
+      !this->dataPtr->shaderFailed)
+  {
+    this->dataPtr->shaderFailed = !this->dataPtr->LoadShaderGrid();
+    dirty |= GRID_DIRTY_CELLS | GRID_DIRTY_COLOR | GRID_DIRTY_VISIBLE;
+  }
+
+  // Fall back to the line grid if the shaders are not available
+  bool shader = gridParam.shader && !this->dataPtr->shaderFailed;
+
+  // Each of these rebuilds the grid geometry, which the shader grid does not
+  // use
+  if ((dirty & GRID_DIRTY_CELLS) && !shader)
+  {
+    if (this->dataPtr->grid->VerticalCellCount() != static_cast<unsigned>(gridParam.vCellCount))
+      this->dataPtr->grid->SetVerticalCellCount(static_cast<unsigned>(gridParam.vCellCount));
+
+    if (this->dataPtr->grid->CellCount() != static_cast<unsigned>(gridParam.hCellCount))
+      this->dataPtr->grid->SetCellCount(static_cast<unsigned>(gridParam.hCellCount));
+
+    if (!ignition::math::equal(this->dataPtr->grid->CellLength(), gridParam.cellLength))
+      this->dataPtr->grid->SetCellLength(gridParam.cellLength);
+  }
 
   auto visual = this->dataPtr->grid->Parent();
   if (visual)
   {
-    visual->SetLocalPose(this->dataPtr->gridParam.pose);
+    if (dirty & GRID_DIRTY_POSE)
+      visual->SetLocalPose(gridParam.pose);
 
-    auto mat = visual->Material();
-    mat->SetAmbient(this->dataPtr->gridParam.color);
-    mat->SetDiffuse(this->dataPtr->gridParam.color);
-    mat->SetSpecular(this->dataPtr->gridParam.color);
+    if (dirty & GRID_DIRTY_COLOR)
+    {
+      auto mat = visual->Material();
+      if (mat)
+      {
+        mat->SetAmbient(gridParam.color);
+        mat->SetDiffuse(gridParam.color);
+        mat->SetSpecular(gridParam.color);
+      }
+    }
 
-    visual->SetVisible(this->dataPtr->gridParam.visible);
+    if (dirty & (GRID_DIRTY_VISIBLE | GRID_DIRTY_MODE))
+      visual->SetVisible(gridParam.visible && !shader);
   }
 
-  this->dataPtr->dirty = true;
+  if (this->dataPtr->shaderGrid)
+  {
+    if (dirty & (GRID_DIRTY_VISIBLE | GRID_DIRTY_MODE))
+      this->dataPtr->shaderGrid->SetVisible(gridParam.visible && shader);
+
+    if (shader)
+      this->dataPtr->UpdateShaderGrid(gridParam, dirty);
+  }
+}
+
+/////////////////////////////////////////////////
+bool TesseractGridConfigPrivate::LoadShaderGrid()
+{
+  std::string vertexShader = std::string(TSW_SHADER_PATH) + "/grid_vs.glsl";
+  std::string fragmentShader = std::string(TSW_SHADER_PATH) + "/grid_fs.glsl";
+  if (!ignition::common::exists(vertexShader) ||
+      !ignition::common::exists(fragmentShader))
+  {
+    ignerr << "Grid shaders not found in [" << TSW_SHADER_PATH
+           << "], using the line grid." << std::endl;
+    return false;
+  }
+
+  // The user camera of the 3D scene
+  for (unsigned int i = 0; i < this->scene->SensorCount() && !this->camera; ++i)
+  {
+    this->camera = std::dynamic_pointer_cast<ignition::rendering::Camera>(
+        this->scene->SensorByIndex(i));
+  }
+
+  if (!this->camera)
+  {
+    ignerr << "No camera found for the shader grid, using the line grid."
+           << std::endl;
+    return false;
+  }
+
+  auto plane = this->scene->CreatePlane();
+  if (!plane)
+  {
+    ignerr << "Failed to create the shader grid plane, using the line grid."
+           << std::endl;
+    return false;
+  }
+
+  auto mat = this->scene->CreateMaterial();
+  mat->SetVertexShader(vertexShader);
+  mat->SetFragmentShader(fragmentShader);
+  mat->SetLightingEnabled(false);
+  mat->SetCastShadows(false);
+  mat->SetDepthWriteEnabled(false);
+
+  // Any transparency enables alpha blending, the alpha itself comes from the
+  // fragment shader
+  mat->SetTransparency(0.5);
+
+  // The plane covers everything the camera can see, whatever it is zoomed to
+  double size = 2.0 * this->camera->FarClipPlane();
+  this->shaderGrid = this->scene->CreateVisual(GRID_SHADER_VISUAL_NAME);
+  this->shaderGrid->AddGeometry(plane);
+  this->shaderGrid->SetLocalScale(size, size, 1.0);
+  this->shaderGrid->SetMaterial(mat);
+  this->scene->RootVisual()->AddChild(this->shaderGrid);
+
+  auto vertexParams = mat->VertexShaderParams();
+  (*vertexParams)["size"] = static_cast<float>(size);
+
+  auto fragmentParams = mat->FragmentShaderParams();
+  (*fragmentParams)["fade_distance"] =
+      static_cast<float>(this->camera->FarClipPlane());
+  (*fragmentParams)["color"].InitializeBuffer(4);
+  (*fragmentParams)["camera_position"].InitializeBuffer(3);
+
+  igndbg << "Created shader grid" << std::endl;
+  return true;
+}
+
+/////////////////////////////////////////////////
+void TesseractGridConfigPrivate::UpdateShaderGrid(const GridParam &_gridParam,
+                                                  unsigned _dirty)
+{
+  ignition::math::Vector3d cameraPosition = this->camera->WorldPosition();
+  if (_dirty == GRID_DIRTY_NONE && cameraPosition == this->shaderGridCamera)
+    return;
+
+  this->shaderGridCamera = cameraPosition;
+
+  // The lines are computed from the world position, so moving the plane with
+  // the camera does not move them
+  double height = _gridParam.pose.Pos().Z();
+  this->shaderGrid->SetWorldPosition(cameraPosition.X(), cameraPosition.Y(),
+                                     height);
+
+  auto mat = this->shaderGrid->Material();
+  auto vertexParams = mat->VertexShaderParams();
+  (*vertexParams)["center_x"] = static_cast<float>(cameraPosition.X());
+  (*vertexParams)["center_y"] = static_cast<float>(cameraPosition.Y());
+
+  auto fragmentParams = mat->FragmentShaderParams();
+  float camera[3] = {static_cast<float>(cameraPosition.X()),
+                     static_cast<float>(cameraPosition.Y()),
+                     static_cast<float>(cameraPosition.Z())};
+  (*fragmentParams)["camera_position"].UpdateBuffer(camera);
+  (*fragmentParams)["height"] = static_cast<float>(height);
+
+  if (_dirty & GRID_DIRTY_CELLS)
+    (*fragmentParams)["cell_length"] = static_cast<float>(_gridParam.cellLength);
+
+  if (_dirty & GRID_DIRTY_COLOR)
+  {
+    float color[4] = {_gridParam.color.R(), _gridParam.color.G(),
+                      _gridParam.color.B(), _gridParam.color.A()};
+    (*fragmentParams)["color"].UpdateBuffer(color);
+  }
 }
 
 /////////////////////////////////////////////////
@@ -181,28 +446,16 @@ void TesseractGridConfig::LoadGrid()
     return;
   }
 
-  // load grid
-  // if gridPtr found, load the existing gridPtr to class
-  for (unsigned int i = 0; i < scene->VisualCount(); ++i)
-  {
-    auto vis = scene->VisualByIndex(i);
-    if (!vis || vis->GeometryCount() == 0)
-      continue;
-    for (unsigned int j = 0; j < vis->GeometryCount(); ++j)
-    {
-      auto grid = std::dynamic_pointer_cast<ignition::rendering::Grid>(
-            vis->GeometryByIndex(j));
-      if (grid)
-      {
-        igndbg << "Attaching to existing grid" << std::endl;
-        this->dataPtr->grid = grid;
-        return;
-      }
-    }
-  }
-
+  // Attach to the grid created by the render utils or another instance of
+  // this plugin, they all register its visual
+  this->dataPtr->scene = scene;
+  this->dataPtr->gridVisualId = getGridVisualId(scene);
+  this->dataPtr->grid = findGrid(scene);
   if (this->dataPtr->grid)
+  {
+    igndbg << "Attaching to existing grid" << std::endl;
     return;
+  }
 
   // Create grid
   igndbg << "Creating grid" << std::endl;
@@ -221,42 +474,51 @@ void TesseractGridConfig::LoadGrid()
     return;
   }
 
-  this->dataPtr->grid->SetCellCount(static_cast<unsigned>(this->dataPtr->gridParam.hCellCount));
-  this->dataPtr->grid->SetVerticalCellCount(static_cast<unsigned>(this->dataPtr->gridParam.vCellCount));
-  this->dataPtr->grid->SetCellLength(this->dataPtr->gridParam.cellLength);
+  // The new grid gets every parameter, only a change of mode is left to apply
+  GridParam gridParam;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    gridParam = this->dataPtr->gridParam;
+    this->dataPtr->dirty &= GRID_DIRTY_MODE;
+  }
+
+  this->dataPtr->grid->SetCellCount(static_cast<unsigned>(gridParam.hCellCount));
+  this->dataPtr->grid->SetVerticalCellCount(static_cast<unsigned>(gridParam.vCellCount));
+  this->dataPtr->grid->SetCellLength(gridParam.cellLength);
 
-  auto vis = scene->CreateVisual();
+  auto vis = scene->CreateVisual(GRID_VISUAL_NAME);
   root->AddChild(vis);
-  vis->SetLocalPose(this->dataPtr->gridParam.pose);
+  vis->SetLocalPose(gridParam.pose);
   vis->AddGeometry(this->dataPtr->grid);
 
   auto mat = scene->CreateMaterial();
-  mat->SetAmbient(this->dataPtr->gridParam.color);
-  mat->SetDiffuse(this->dataPtr->gridParam.color);
-  mat->SetSpecular(this->dataPtr->gridParam.color);
+  mat->SetAmbient(gridParam.color);
+  mat->SetDiffuse(gridParam.color);
+  mat->SetSpecular(gridParam.color);
 
   vis->SetMaterial(mat); // IGNITION BUG: This was missing
+  vis->SetVisible(gridParam.visible && !gridParam.shader);
+
+  registerGrid(scene, vis);
+  this->dataPtr->gridVisualId = vis->Id();
 }
 
 /////////////////////////////////////////////////
 void TesseractGridConfig::UpdateVCellCount(int _cellCount)
 {
-  this->dataPtr->gridParam.vCellCount = _cellCount;
-  this->dataPtr->dirty = true;
+  this->dataPtr->Set(this->dataPtr->gridParam.vCellCount, _cellCount, GRID_DIRTY_CELLS);
 }
 
 /////////////////////////////////////////////////
 void TesseractGridConfig::UpdateHCellCount(int _cellCount)
 {
-  this->dataPtr->gridParam.hCellCount = _cellCount;
-  this->dataPtr->dirty = true;
+  this->dataPtr->Set(this->dataPtr->gridParam.hCellCount, _cellCount, GRID_DIRTY_CELLS);
 }
 
 /////////////////////////////////////////////////
 void TesseractGridConfig::UpdateCellLength(double _length)
 {
-  this->dataPtr->gridParam.cellLength = _length;
-  this->dataPtr->dirty = true;
+  this->dataPtr->Set(this->dataPtr->gridParam.cellLength, _length, GRID_DIRTY_CELLS);
 }
 
 /////////////////////////////////////////////////
@@ -264,25 +526,32 @@ void TesseractGridConfig::SetPose(
   double _x, double _y, double _z,
   double _roll, double _pitch, double _yaw)
 {
-  this->dataPtr->gridParam.pose = ignition::math::Pose3d(_x, _y, _z, _roll, _pitch, _yaw);
-  this->dataPtr->dirty = true;
+  this->dataPtr->Set(this->dataPtr->gridParam.pose,
+                     ignition::math::Pose3d(_x, _y, _z, _roll, _pitch, _yaw),
+                     GRID_DIRTY_POSE);
 }
 
 /////////////////////////////////////////////////
 void TesseractGridConfig::SetColor(double _r, double _g, double _b, double _a)
 {
-  this->dataPtr->gridParam.color = ignition::math::Color(static_cast<float>(_r),
-                                                         static_cast<float>(_g),
-                                                         static_cast<float>(_b),
-                                                         static_cast<float>(_a));
-  this->dataPtr->dirty = true;
+  this->dataPtr->Set(this->dataPtr->gridParam.color,
+                     ignition::math::Color(static_cast<float>(_r),
+                                           static_cast<float>(_g),
+                                           static_cast<float>(_b),
+                                           static_cast<float>(_a)),
+                     GRID_DIRTY_COLOR);
 }
 
 /////////////////////////////////////////////////
 void TesseractGridConfig::OnShow(bool _checked)
 {
-  this->dataPtr->gridParam.visible = _checked;
-  this->dataPtr->dirty = true;
+  this->dataPtr->Set(this->dataPtr->gridParam.visible, _checked, GRID_DIRTY_VISIBLE);
+}
+
+/////////////////////////////////////////////////
+void TesseractGridConfig::OnShaderMode(bool _checked)
+{
+  this->dataPtr->Set(this->dataPtr->gridParam.shader, _checked, GRID_DIRTY_MODE);
 }
 
 // Register this plugin
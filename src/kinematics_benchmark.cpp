@@ -0,0 +1,295 @@
+/**
+ * @file kinematics_benchmark.cpp
+ * @brief Measure the throughput and latency of the kinematic solvers of the environment's groups
+ *
+ * @author Levi Armstrong
+ * @date October 18, 2026
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @copyright Copyright (c) 2020, Southwest Research Institute
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <tesseract_ignition/kinematics_benchmark.h>
+#include <tesseract_kinematics/core/forward_kinematics.h>
+#include <tesseract_kinematics/core/inverse_kinematics.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <future>
+#include <random>
+#include <thread>
+
+namespace tesseract_ignition
+{
+
+namespace
+{
+/** @brief The inputs of one benchmark call, sampled before timing starts */
+struct BenchmarkSample
+{
+  Eigen::VectorXd joint_values;
+  Eigen::VectorXd seed;
+  Eigen::Isometry3d pose;
+};
+
+/** @brief The measurements of one thread */
+struct ChunkResult
+{
+  std::vector<double> latencies;
+  long successes {0};
+  long solutions {0};
+
+  /** @brief When the timed calls of the thread started and ended */
+  std::chrono::steady_clock::time_point start;
+  std::chrono::steady_clock::time_point end;
+};
+
+/** @brief Get the joint limits of the solver, joints without a usable range get [-pi, pi] */
+Eigen::MatrixX2d getSampleLimits(const tesseract_kinematics::ForwardKinematics& fwd_kin)
+{
+  Eigen::MatrixX2d limits = fwd_kin.getLimits();
+  for (Eigen::Index i = 0; i < limits.rows(); ++i)
+  {
+    if (!std::isfinite(limits(i, 0)) || !std::isfinite(limits(i, 1)) || limits(i, 0) >= limits(i, 1))
+    {
+      limits(i, 0) = -M_PI;
+      limits(i, 1) = M_PI;
+    }
+  }
+  return limits;
+}
+
+Eigen::VectorXd sampleState(const Eigen::MatrixX2d& limits, std::mt19937& rng)
+{
+  std::uniform_real_distribution<double> unit(0.0, 1.0);
+  Eigen::VectorXd state(limits.rows());
+  for (Eigen::Index i = 0; i < limits.rows(); ++i)
+    state(i) = limits(i, 0) + unit(rng) * (limits(i, 1) - limits(i, 0));
+  return state;
+}
+
+/** @brief Check if a pose is within tolerance of the target */
+bool isSamePose(const Eigen::Isometry3d& target, const Eigen::Isometry3d& pose, const KinematicsBenchmarkConfig& config)
+{
+  if ((pose.translation() - target.translation()).norm() > config.position_tolerance)
+    return false;
+
+  return Eigen::AngleAxisd(target.linear().transpose() * pose.linear()).angle() <= config.orientation_tolerance;
+}
+
+double percentile(const std::vector<double>& sorted, double fraction)
+{
+  if (sorted.empty())
+    return 0;
+
+  auto index = static_cast<std::size_t>(std::ceil(fraction * static_cast<double>(sorted.size())));
+  return sorted[std::min(std::max(index, std::size_t(1)), sorted.size()) - 1];
+}
+
+/**
+ * @brief Run a benchmark split across threads and merge the measurements
+ * @param samples The inputs of every call
+ * @param thread_count The number of threads
+ * @param make_chunk Called in this thread for the inputs in [begin, end), it clones the solvers and returns the
+ * function run in the chunk's thread. That function records the start and end of its timed calls, so the cloning and
+ * any checking done after the calls are not part of the benchmark time.
+ */
+template <typename MakeChunk>
+KinematicsBenchmarkResult runBenchmark(const std::vector<BenchmarkSample>& samples,
+                                       unsigned thread_count,
+                                       const MakeChunk& make_chunk)
+{
+  std::size_t chunk_size = (samples.size() + thread_count - 1) / thread_count;
+
+  std::vector<decltype(make_chunk(std::size_t(0), std::size_t(0)))> runs;
+  for (std::size_t begin = 0; begin < samples.size(); begin += chunk_size)
+    runs.push_back(make_chunk(begin, std::min(begin + chunk_size, samples.size())));
+
+  std::vector<std::future<ChunkResult>> chunks;
+  chunks.reserve(runs.size());
+  for (auto& run : runs)
+    chunks.push_back(std::async(std::launch::async, std::move(run)));
+
+  KinematicsBenchmarkResult result;
+  std::vector<double> latencies;
+  latencies.reserve(samples.size());
+  auto start = std::chrono::steady_clock::time_point::max();
+  auto end = std::chrono::steady_clock::time_point::min();
+  for (auto& chunk : chunks)
+  {
+    ChunkResult r = chunk.get();
+    result.successes += r.successes;
+    result.solutions += r.solutions;
+    latencies.insert(latencies.end(), r.latencies.begin(), r.latencies.end());
+    start = std::min(start, r.start);
+    end = std::max(end, r.end);
+  }
+  result.seconds = (end > start) ? std::chrono::duration<double>(end - start).count() : 0.0;
+
+  std::sort(latencies.begin(), latencies.end());
+  result.calls = static_cast<long>(latencies.size());
+  result.latency_p50 = percentile(latencies, 0.50);
+  result.latency_p90 = percentile(latencies, 0.90);
+  result.latency_p99 = percentile(latencies, 0.99);
+  result.latency_max = latencies.empty() ? 0 : latencies.back();
+  return result;
+}
+
+/** @brief The time since start in microseconds */
+double elapsedMicroseconds(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+}
+
+double KinematicsBenchmarkResult::getCallsPerSecond() const
+{
+  return (seconds > 0) ? static_cast<double>(calls) / seconds : 0.0;
+}
+
+double KinematicsBenchmarkResult::getSolutionsPerSecond() const
+{
+  return (seconds > 0) ? static_cast<double>(solutions) / seconds : 0.0;
+}
+
+double KinematicsBenchmarkResult::getSuccessRate() const
+{
+  return (calls > 0) ? static_cast<double>(successes) / static_cast<double>(calls) : 0.0;
+}
+
+std::vector<KinematicsBenchmarkResult> benchmarkKinematics(const tesseract_environment::Environment& env,
+                                                           const std::string& group_name,
+                                                           const KinematicsBenchmarkConfig& config)
+{
+  auto manager = env.getManipulatorManager();
+  tesseract_kinematics::ForwardKinematics::Ptr reference = manager->getFwdKinematicSolver(group_name);
+  if (reference == nullptr)
+    return {};
+
+  unsigned thread_count = (config.threads > 0) ? config.threads : std::max(1U, std::thread::hardware_concurrency());
+
+  // Sample the inputs up front so only the solver calls are timed
+  Eigen::MatrixX2d limits = getSampleLimits(*reference);
+  std::mt19937 rng(config.seed);
+  std::vector<BenchmarkSample> samples;
+  samples.reserve(static_cast<std::size_t>(std::max(config.samples, 0L)));
+  for (long i = 0; i < config.samples; ++i)
+  {
+    BenchmarkSample sample;
+    sample.joint_values = sampleState(limits, rng);
+    sample.seed = sampleState(limits, rng);
+    if (reference->calcFwdKin(sample.pose, sample.joint_values))
+      samples.push_back(sample);
+  }
+
+  if (samples.empty())
+    return {};
+
+  std::vector<KinematicsBenchmarkResult> results;
+  for (const auto& solver_name : manager->getAvailableFwdKinematicsSolvers(group_name))
+  {
+    tesseract_kinematics::ForwardKinematics::Ptr solver = manager->getFwdKinematicSolver(group_name, solver_name);
+    if (solver == nullptr)
+      continue;
+
+    KinematicsBenchmarkResult result = runBenchmark(samples, thread_count, [&samples, &solver](std::size_t begin, std::size_t end) {
+      tesseract_kinematics::ForwardKinematics::Ptr kin = solver->clone();
+      return [&samples, kin, begin, end]() {
+        ChunkResult chunk;
+        chunk.latencies.reserve(end - begin);
+        Eigen::Isometry3d pose;
+        chunk.start = std::chrono::steady_clock::now();
+        for (std::size_t i = begin; i < end; ++i)
+        {
+          auto start = std::chrono::steady_clock::now();
+          bool found = kin->calcFwdKin(pose, samples[i].joint_values);
+          chunk.latencies.push_back(elapsedMicroseconds(start));
+          if (found)
+          {
+            ++chunk.successes;
+            ++chunk.solutions;
+          }
+        }
+        chunk.end = std::chrono::steady_clock::now();
+        return chunk;
+      };
+    });
+
+    result.group_name = group_name;
+    result.solver_name = solver_name;
+    result.inverse = false;
+    results.push_back(result);
+  }
+
+  for (const auto& solver_name : manager->getAvailableInvKinematicsSolvers(group_name))
+  {
+    tesseract_kinematics::InverseKinematics::Ptr solver = manager->getInvKinematicSolver(group_name, solver_name);
+    if (solver == nullptr)
+      continue;
+
+    KinematicsBenchmarkResult result = runBenchmark(samples, thread_count, [&samples, &solver, &reference, &config](std::size_t begin, std::size_t end) {
+      tesseract_kinematics::InverseKinematics::Ptr kin = solver->clone();
+      tesseract_kinematics::ForwardKinematics::Ptr fwd_kin = reference->clone();
+      return [&samples, &config, kin, fwd_kin, begin, end]() {
+        ChunkResult chunk;
+        chunk.latencies.reserve(end - begin);
+        std::vector<Eigen::VectorXd> solutions(end - begin);
+        std::vector<bool> found(end - begin, false);
+        chunk.start = std::chrono::steady_clock::now();
+        for (std::size_t i = begin; i < end; ++i)
+        {
+          auto start = std::chrono::steady_clock::now();
+          found[i - begin] = kin->calcInvKin(solutions[i - begin], samples[i].pose, samples[i].seed);
+          chunk.latencies.push_back(elapsedMicroseconds(start));
+        }
+        chunk.end = std::chrono::steady_clock::now();
+
+        // Only solutions which reproduce the target pose are counted, they are checked after the timed calls
+        Eigen::Isometry3d pose;
+        auto dof = static_cast<Eigen::Index>(kin->numJoints());
+        for (std::size_t i = begin; i < end; ++i)
+        {
+          if (!found[i - begin] || dof == 0)
+            continue;
+
+          const Eigen::VectorXd& sample_solutions = solutions[i - begin];
+          long valid = 0;
+          for (Eigen::Index s = 0; s + dof <= sample_solutions.size(); s += dof)
+          {
+            if (fwd_kin->calcFwdKin(pose, sample_solutions.segment(s, dof)) && isSamePose(samples[i].pose, pose, config))
+              ++valid;
+          }
+
+          chunk.solutions += valid;
+          if (valid > 0)
+            ++chunk.successes;
+        }
+        return chunk;
+      };
+    });
+
+    result.group_name = group_name;
+    result.solver_name = solver_name;
+    result.inverse = true;
+    results.push_back(result);
+  }
+
+  return results;
+}
+
+}
@@ -0,0 +1,189 @@
+/**
+ * @file package_resolver.cpp
+ * @brief Find the directories of ROS packages by name
+ *
+ * @author Levi Armstrong
+ * @date October 18, 2026
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @copyright Copyright (c) 2020, Southwest Research Institute
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_ignition/package_resolver.h>
+#include <cstdlib>
+#include <future>
+#include <unordered_set>
+#include <utility>
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/algorithm/string/split.hpp>
+#include <ignition/common/Console.hh>
+#include <QDir>
+#include <QFile>
+#include <QXmlStreamReader>
+
+namespace tesseract_ignition
+{
+
+/** @brief The packages found below one search path, in the order they were found */
+struct CrawlResult
+{
+  bool exists {false};
+  std::vector<std::pair<std::string, std::string>> packages;
+};
+
+/** @brief Read the name of a package from its package.xml, empty if it has none */
+static std::string readPackageName(const QString& filepath)
+{
+  QFile file(filepath);
+  if (!file.open(QIODevice::ReadOnly))
+    return std::string();
+
+  // The name is a child of the root package element
+  QXmlStreamReader xml(&file);
+  if (!xml.readNextStartElement() || xml.name() != QLatin1String("package"))
+    return std::string();
+
+  while (xml.readNextStartElement())
+  {
+    if (xml.name() == QLatin1String("name"))
+      return xml.readElementText().trimmed().toStdString();
+
+    xml.skipCurrentElement();
+  }
+
+  return std::string();
+}
+
+/** @brief Find the packages below a search path, this only uses its own QDir instances so it can run in any thread */
+static CrawlResult crawlSearchPath(const std::string& search_path)
+{
+  CrawlResult result;
+  QDir root(QString::fromStdString(search_path));
+  result.exists = root.exists();
+  if (!result.exists)
+    return result;
+
+  static const QStringList ignore_files = { "CATKIN_IGNORE", "COLCON_IGNORE", "AMENT_IGNORE" };
+
+  // Symbolic links are followed, the canonical paths already searched stop them from looping
+  std::unordered_set<std::string> visited;
+  std::vector<QString> stack { root.absolutePath() };
+  while (!stack.empty())
+  {
+    QDir dir(stack.back());
+    stack.pop_back();
+
+    if (!visited.insert(dir.canonicalPath().toStdString()).second)
+      continue;
+
+    if (dir.exists("package.xml"))
+    {
+      std::string name = readPackageName(dir.filePath("package.xml"));
+      if (name.empty())
+        name = dir.dirName().toStdString();
+
+      result.packages.emplace_back(name, dir.absolutePath().toStdString());
+      continue;
+    }
+
+    bool ignored = false;
+    for (const auto& ignore_file : ignore_files)
+      ignored = ignored || dir.exists(ignore_file);
+
+    if (ignored)
+      continue;
+
+    // Pushed in reverse so the directories are searched in name order
+    QStringList children = dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot, QDir::Name);
+    for (auto it = children.crbegin(); it != children.crend(); ++it)
+      stack.push_back(dir.filePath(*it));
+  }
+
+  return result;
+}
+
+PackageResolver::PackageResolver(std::vector<std::string> search_paths) : search_paths_(std::move(search_paths)) {}
+
+std::vector<std::string> PackageResolver::getEnvironmentSearchPaths()
+{
+  std::vector<std::string> search_paths;
+  for (const char* variable : { "TSW_RESOURCE_PATH", "ROS_PACKAGE_PATH" })
+  {
+    char* paths = std::getenv(variable);
+    if (paths == nullptr)
+      continue;
+
+    std::vector<std::string> tokens;
+    boost::split(tokens, paths, boost::is_any_of(":"), boost::token_compress_on);
+    for (auto& token : tokens)
+    {
+      if (!token.empty())
+        search_paths.push_back(std::move(token));
+    }
+  }
+
+  return search_paths;
+}
+
+std::string PackageResolver::findPackage(const std::string& name) const
+{
+  std::call_once(crawled_, [this]() { crawl(); });
+
+  auto it = packages_.find(name);
+  if (it == packages_.end())
+    return std::string();
+
+  return it->second;
+}
+
+const std::vector<std::string>& PackageResolver::getSearchPaths() const { return search_paths_; }
+
+void PackageResolver::crawl() const
+{
+  std::vector<std::future<CrawlResult>> futures;
+  futures.reserve(search_paths_.size());
+  for (const auto& search_path : search_paths_)
+    futures.push_back(std::async(std::launch::async, crawlSearchPath, search_path));
+
+  std::vector<CrawlResult> results;
+  results.reserve(futures.size());
+  for (auto& future : futures)
+    results.push_back(future.get());
+
+  // Merge in search path order so the earliest search path wins
+  for (std::size_t i = 0; i < results.size(); ++i)
+  {
+    if (!results[i].exists)
+    {
+      ignwarn << "ROS Package Path does not exist: " << search_paths_[i] << std::endl;
+      continue;
+    }
+
+    for (const auto& package : results[i].packages)
+      packages_.insert(package);
+  }
+
+  for (std::size_t i = 0; i < results.size(); ++i)
+  {
+    if (results[i].exists)
+      packages_.emplace(QDir(QString::fromStdString(search_paths_[i])).dirName().toStdString(), search_paths_[i]);
+  }
+
+  igndbg << "Found " << packages_.size() << " packages in " << search_paths_.size() << " search paths" << std::endl;
+}
+
+}
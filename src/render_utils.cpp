@@ -15,6 +15,7 @@
  *
  */
 
+#include <algorithm>
 #include <map>
 #include <unordered_map>
 #include <unordered_set>
@@ -37,6 +38,7 @@
 
 #include <tesseract_ignition/render_utils.h>
 #include <tesseract_ignition/conversions.h>
+#include <tesseract_ignition/grid/grid_utils.h>
 
 namespace tesseract_ignition
 {
@@ -61,6 +63,12 @@ namespace tesseract_ignition
       /** @brief Set Environment transforms to be applied to the scene and tesseract environment */
       tesseract_common::TransformMap transfroms;
 
+      /** @brief Joint values queued since the last update, solved together on the next update */
+      std::unordered_map<std::string, double> pending_joints;
+
+      /** @brief The number of times an environment has been loaded into the scene */
+      int scene_revision {0};
+
       /** @brief This stores the Environment revision number to determine if new objects should be added */
       int environment_revision {-1};
 
@@ -88,8 +96,11 @@ namespace tesseract_ignition
       /** @brief Flag to indicate if the current GL context should be used */
       bool use_current_gl_context {false};
 
-//      /// \brief A map of entity ids and wire boxes
-//      std::unordered_map<EntityID, ignition::rendering::WireBoxPtr> wireBoxes;
+      /** @brief The wire box of each entity highlighted so far, hidden rather than destroyed when lowlighted */
+      std::unordered_map<tesseract_visualization::EntityID, ignition::rendering::WireBoxPtr> wire_boxes;
+
+      /** @brief The material shared by all wire boxes, created on the first highlight */
+      ignition::rendering::MaterialPtr highlight_material;
 
 //      /// \brief A map of entity ids and trajectory pose updates.
 //      std::unordered_map<EntityID, ignition::math::Pose3d> trajectoryPoses;
@@ -124,6 +135,18 @@ namespace tesseract_ignition
       /** @brief Currently selected entities, organized by order of selection. */
       std::vector<tesseract_visualization::EntityID> selectedEntities;
 
+      /** @brief True if a selection has been requested since the last update */
+      bool pending_selection_set {false};
+
+      /** @brief The entities requested to be selected, applied on the next update */
+      std::vector<tesseract_visualization::EntityID> pending_selection;
+
+      /** @brief The links requested to be selected, resolved to entities on the next update */
+      std::vector<std::string> pending_selection_links;
+
+      /** @brief The number of times update has applied a selection */
+      int selection_revision {0};
+
       /** @brief Map of original emissive colors for nodes currently highlighted. */
       std::map<std::string, ignition::math::Color> originalEmissive;
 
@@ -140,6 +163,9 @@ namespace tesseract_ignition
        * param[in] _node Node to be restored.
        */
       void lowlightNode(const ignition::rendering::NodePtr &_node);
+
+      /** @brief Destroy the wire box visuals, this must be done before the entities they are attached to */
+      void destroyWireBoxes();
   };
 
   //////////////////////////////////////////////////
@@ -208,6 +234,15 @@ namespace tesseract_ignition
   //////////////////////////////////////////////////
   tesseract_environment::Environment::ConstPtr RenderUtil::getEnvironmentConst() const { return this->dataPtr->env; }
 
+  //////////////////////////////////////////////////
+  const tesseract_visualization::EntityManager& RenderUtil::getEntityManager() const
+  {
+    return this->dataPtr->entity_manager;
+  }
+
+  //////////////////////////////////////////////////
+  int RenderUtil::getSceneRevision() const { return this->dataPtr->scene_revision; }
+
   //////////////////////////////////////////////////
   void RenderUtil::setEnvironmentCommands(tesseract_environment::Commands commands)
   {
@@ -245,6 +280,15 @@ namespace tesseract_ignition
     this->dataPtr->update_mutex.unlock();
   }
 
+  //////////////////////////////////////////////////
+  void RenderUtil::queueEnvironmentState(const std::unordered_map<std::string, double>& joints)
+  {
+    this->dataPtr->update_mutex.lock();
+    for (const auto& joint : joints)
+      this->dataPtr->pending_joints[joint.first] = joint.second;
+    this->dataPtr->update_mutex.unlock();
+  }
+
 //  //////////////////////////////////////////////////
 //  int RenderUtil::PendingSensors() const
 //  {
@@ -267,15 +311,37 @@ namespace tesseract_ignition
       return;
 
     this->dataPtr->update_mutex.lock();
+    if (!this->dataPtr->pending_joints.empty())
+    {
+      this->dataPtr->env->setState(this->dataPtr->pending_joints);
+      this->dataPtr->transfroms = this->dataPtr->env->getCurrentState()->link_transforms;
+      this->dataPtr->pending_joints.clear();
+    }
+
     tesseract_environment::Commands commands = std::move(this->dataPtr->commands);
     tesseract_common::TransformMap transforms = std::move(this->dataPtr->transfroms);
+    bool selection_set = this->dataPtr->pending_selection_set;
+    std::vector<tesseract_visualization::EntityID> selection = std::move(this->dataPtr->pending_selection);
+    std::vector<std::string> selection_links = std::move(this->dataPtr->pending_selection_links);
 
     this->dataPtr->commands.clear();
     this->dataPtr->transfroms.clear();
+    this->dataPtr->pending_selection_set = false;
+    this->dataPtr->pending_selection.clear();
+    this->dataPtr->pending_selection_links.clear();
     this->dataPtr->update_mutex.unlock();
 
     if (this->dataPtr->load_environment)
     {      
+      // The entities of the previous environment are destroyed, so the selection and its wire boxes go with them
+      if (!this->dataPtr->selectedEntities.empty())
+      {
+        this->dataPtr->selectedEntities.clear();
+        this->dataPtr->originalEmissive.clear();
+        ++this->dataPtr->selection_revision;
+      }
+      this->dataPtr->destroyWireBoxes();
+
 //      this->dataPtr->scene->Clear(); This is causing issues but it is best to probably only remove tesseract entities
       for (const auto& pair : this->dataPtr->entity_manager.getLinks())
         this->dataPtr->scene->DestroyNodeById(static_cast<unsigned>(pair.second));
@@ -298,6 +364,7 @@ namespace tesseract_ignition
       showGrid();
       showWorldAxis();
       this->dataPtr->load_environment = false;
+      ++this->dataPtr->scene_revision;
     }
     else if (this->dataPtr->env)
     {
@@ -324,17 +391,46 @@ namespace tesseract_ignition
         }
       }
 
-  //    if (this->data_->update_selections)
-  //    {
-  //      for (const auto& id : this->data_->selected_entities)
-  //      {
-  //        ignition::rendering::VisualPtr v = this->data_->scene->VisualById(id);
-  //  //      if(v)
-  //  //      {
-  //  //        v->SetH
-  //  //      }
-  //      }
-  //    }
+    }
+
+    if (selection_set)
+    {
+      const auto& links = this->dataPtr->entity_manager.getLinks();
+      for (const auto& link_name : selection_links)
+      {
+        auto it = links.find(link_name);
+        if (it != links.end())
+          selection.push_back(it->second);
+      }
+
+      // Only the entities leaving the selection are lowlighted, the others keep their wire box visible
+      for (const auto& entity_id : this->dataPtr->selectedEntities)
+      {
+        if (std::find(selection.begin(), selection.end(), entity_id) == selection.end())
+          this->dataPtr->lowlightNode(this->dataPtr->scene->NodeById(static_cast<unsigned>(entity_id)));
+      }
+
+      std::vector<tesseract_visualization::EntityID> selected_entities;
+      for (const auto& entity_id : selection)
+      {
+        if (std::find(selected_entities.begin(), selected_entities.end(), entity_id) != selected_entities.end())
+          continue;
+
+        // The grids and world axis can be clicked in the scene but are not part of the environment
+        ignition::rendering::NodePtr node = this->dataPtr->scene->NodeById(static_cast<unsigned>(entity_id));
+        if (!node || node->Name() == GRID_VISUAL_NAME || node->Name() == GRID_SHADER_VISUAL_NAME ||
+            node->Name() == "tesseract_world_axis")
+          continue;
+
+        selected_entities.push_back(entity_id);
+        this->dataPtr->highlightNode(node);
+      }
+
+      if (selected_entities != this->dataPtr->selectedEntities)
+      {
+        this->dataPtr->selectedEntities = std::move(selected_entities);
+        ++this->dataPtr->selection_revision;
+      }
     }
   }
 
@@ -384,7 +480,7 @@ namespace tesseract_ignition
   /////////////////////////////////////////////////
   void RenderUtil::showGrid()
   {
-    ignition::rendering::VisualPtr visual = this->dataPtr->scene->VisualByName("tesseract_grid");
+    ignition::rendering::VisualPtr visual = findGridVisual(this->dataPtr->scene);
     if (visual == nullptr)
     {
       ignition::rendering::VisualPtr root = this->dataPtr->scene->RootVisual();
@@ -396,8 +492,8 @@ namespace tesseract_ignition
       gray->SetSpecular(0.7, 0.7, 0.7);
 
       // create grid visual
-      unsigned id = static_cast<unsigned>(this->dataPtr->entity_manager.addVisual("tesseract_grid"));
-      ignition::rendering::VisualPtr visual = this->dataPtr->scene->CreateVisual(id, "tesseract_grid");
+      unsigned id = static_cast<unsigned>(this->dataPtr->entity_manager.addVisual(GRID_VISUAL_NAME));
+      ignition::rendering::VisualPtr visual = this->dataPtr->scene->CreateVisual(id, GRID_VISUAL_NAME);
       ignition::rendering::GridPtr gridGeom = this->dataPtr->scene->CreateGrid();
       if (!gridGeom)
       {
@@ -414,6 +510,7 @@ namespace tesseract_ignition
       visual->SetLocalPosition(0, 0, 0.015);
       visual->SetMaterial(gray);
       root->AddChild(visual);
+      registerGrid(this->dataPtr->scene, visual);
     }
     else
     {
@@ -424,7 +521,7 @@ namespace tesseract_ignition
   /////////////////////////////////////////////////
   void RenderUtil::hideGrid()
   {
-    ignition::rendering::VisualPtr visual = this->dataPtr->scene->VisualByName("tesseract_grid");
+    ignition::rendering::VisualPtr visual = findGridVisual(this->dataPtr->scene);
     if (visual != nullptr)
       visual->SetVisible(false);
   }
@@ -494,6 +591,7 @@ namespace tesseract_ignition
 
     this->dataPtr->selectedEntities.push_back(entityId);
     this->dataPtr->highlightNode(node);
+    ++this->dataPtr->selection_revision;
   }
 
   /////////////////////////////////////////////////
@@ -504,10 +602,36 @@ namespace tesseract_ignition
       auto node = this->dataPtr->scene->NodeById(static_cast<unsigned>(entity_id));
       this->dataPtr->lowlightNode(node);
     }
+    if (!this->dataPtr->selectedEntities.empty())
+      ++this->dataPtr->selection_revision;
+
     this->dataPtr->selectedEntities.clear();
     this->dataPtr->originalEmissive.clear();
   }
 
+  /////////////////////////////////////////////////
+  void RenderUtil::selectEntities(const std::vector<tesseract_visualization::EntityID>& entities)
+  {
+    this->dataPtr->update_mutex.lock();
+    this->dataPtr->pending_selection_set = true;
+    this->dataPtr->pending_selection = entities;
+    this->dataPtr->pending_selection_links.clear();
+    this->dataPtr->update_mutex.unlock();
+  }
+
+  /////////////////////////////////////////////////
+  void RenderUtil::selectLinks(const std::vector<std::string>& link_names)
+  {
+    this->dataPtr->update_mutex.lock();
+    this->dataPtr->pending_selection_set = true;
+    this->dataPtr->pending_selection.clear();
+    this->dataPtr->pending_selection_links = link_names;
+    this->dataPtr->update_mutex.unlock();
+  }
+
+  /////////////////////////////////////////////////
+  int RenderUtil::getSelectionRevision() const { return this->dataPtr->selection_revision; }
+
   /////////////////////////////////////////////////
   std::vector<tesseract_visualization::EntityID> RenderUtil::selectedEntities() const
   {
@@ -523,66 +647,74 @@ namespace tesseract_ignition
   ////////////////////////////////////////////////
   void RenderUtilPrivate::highlightNode(const ignition::rendering::NodePtr &_node)
   {
-    if (!_node)
+    auto vis = std::dynamic_pointer_cast<ignition::rendering::Visual>(_node);
+    if (!vis)
       return;
-//    auto vis = std::dynamic_pointer_cast<ignition::rendering::Visual>(_node);
-//    EntityID entityId = NULL_ENTITY_ID;
-//    if (vis)
-//      entityId = static_cast<int>(vis->Id());
-    // If the entity is not found in the existing map, create a wire box
-//    auto wireBoxIt = this->wireBoxes.find(entityId);
-//    if (wireBoxIt == this->wireBoxes.end())
-//    {
-//      auto white = this->scene->Material("highlight_material");
-//      if (!white)
-//      {
-//        white = this->scene->CreateMaterial("highlight_material");
-//        white->SetAmbient(1.0, 1.0, 1.0);
-//        white->SetDiffuse(1.0, 1.0, 1.0);
-//        white->SetSpecular(1.0, 1.0, 1.0);
-//        white->SetEmissive(1.0, 1.0, 1.0);
-//      }
 
-//      ignition::rendering::WireBoxPtr wireBox = this->scene->CreateWireBox();
-//      ignition::math::AxisAlignedBox aabb = vis->LocalBoundingBox();
-//      wireBox->SetBox(aabb);
-
-//      // Create visual and add wire box
-//      ignition::rendering::VisualPtr wireBoxVis =
-//        this->scene->CreateVisual();
-//      wireBoxVis->SetInheritScale(false);
-//      wireBoxVis->AddGeometry(wireBox);
-//      wireBoxVis->SetMaterial(white, false);
-//      vis->AddChild(wireBoxVis);
-
-//      // Add wire box to map for setting visibility
-//      this->wireBoxes.insert(std::pair<EntityID, ignition::rendering::WireBoxPtr>(entityId, wireBox));
-//    }
-//    else
-//    {
-//      ignition::rendering::WireBoxPtr wireBox = wireBoxIt->second;
-//      auto visParent = wireBox->Parent();
-//      if (visParent)
-//        visParent->SetVisible(true);
-//    }
+    auto entity_id = static_cast<tesseract_visualization::EntityID>(vis->Id());
+
+    // Reuse the wire box of an entity highlighted before
+    auto wire_box_it = this->wire_boxes.find(entity_id);
+    if (wire_box_it != this->wire_boxes.end())
+    {
+      auto vis_parent = wire_box_it->second->Parent();
+      if (vis_parent)
+        vis_parent->SetVisible(true);
+
+      return;
+    }
+
+    if (!this->highlight_material)
+    {
+      this->highlight_material = this->scene->Material("tesseract_highlight_material");
+      if (!this->highlight_material)
+      {
+        this->highlight_material = this->scene->CreateMaterial("tesseract_highlight_material");
+        this->highlight_material->SetAmbient(1.0, 1.0, 1.0);
+        this->highlight_material->SetDiffuse(1.0, 1.0, 1.0);
+        this->highlight_material->SetSpecular(1.0, 1.0, 1.0);
+        this->highlight_material->SetEmissive(1.0, 1.0, 1.0);
+      }
+    }
+
+    ignition::rendering::WireBoxPtr wire_box = this->scene->CreateWireBox();
+    wire_box->SetBox(vis->LocalBoundingBox());
+
+    // Create visual and add wire box
+    ignition::rendering::VisualPtr wire_box_vis = this->scene->CreateVisual();
+    wire_box_vis->SetInheritScale(false);
+    wire_box_vis->AddGeometry(wire_box);
+    wire_box_vis->SetMaterial(this->highlight_material, false);
+    vis->AddChild(wire_box_vis);
+
+    this->wire_boxes[entity_id] = wire_box;
   }
 
   ////////////////////////////////////////////////
   void RenderUtilPrivate::lowlightNode(const ignition::rendering::NodePtr &_node)
   {
-    if (!_node)
+    auto vis = std::dynamic_pointer_cast<ignition::rendering::Visual>(_node);
+    if (!vis)
       return;
-//    auto vis = std::dynamic_pointer_cast<ignition::rendering::Visual>(_node);
-//    EntityID entityId = NULL_ENTITY_ID;
-//    if (vis)
-//      entityId = static_cast<int>(vis->Id());
-
-//    if (this->wireBoxes.find(entityId) != this->wireBoxes.end())
-//    {
-//      ignition::rendering::WireBoxPtr wireBox = this->wireBoxes[entityId];
-//      auto visParent = wireBox->Parent();
-//      if (visParent)
-//        visParent->SetVisible(false);
-//    }
+
+    auto wire_box_it = this->wire_boxes.find(static_cast<tesseract_visualization::EntityID>(vis->Id()));
+    if (wire_box_it != this->wire_boxes.end())
+    {
+      auto vis_parent = wire_box_it->second->Parent();
+      if (vis_parent)
+        vis_parent->SetVisible(false);
+    }
+  }
+
+  ////////////////////////////////////////////////
+  void RenderUtilPrivate::destroyWireBoxes()
+  {
+    for (const auto& pair : this->wire_boxes)
+    {
+      auto vis_parent = pair.second->Parent();
+      if (vis_parent)
+        this->scene->DestroyVisual(vis_parent, true);
+    }
+    this->wire_boxes.clear();
   }
 }
@@ -19,6 +19,7 @@
 #include <map>
 #include <sstream>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include <ignition/common/Console.hh>
@@ -43,6 +44,7 @@
 
 #include <tesseract_ignition/scene3d/tesseract_scene3d.h>
 #include <tesseract_ignition/gui_events.h>
+#include <tesseract_ignition/grid/grid_utils.h>
 
 namespace tesseract_ignition
 {
@@ -213,6 +215,24 @@ namespace plugins
     /// \brief Ray query for mouse clicks
     public: ignition::rendering::RayQueryPtr rayQuery;
 
+    /// \brief True if a mouse press has not been handled yet
+    public: bool pressPending = false;
+
+    /// \brief True if the mouse has been dragged since the last press
+    public: bool pressDragged = false;
+
+    /// \brief True if a left click without dragging has not been handled yet
+    public: bool clickPending = false;
+
+    /// \brief The visual under the mouse when it was last pressed
+    public: ignition::rendering::VisualPtr pressVisual;
+
+    /// \brief True if target was picked for the last scroll at scrollPos
+    public: bool scrollTargetValid = false;
+
+    /// \brief Mouse position of the last scroll
+    public: ignition::math::Vector2i scrollPos;
+
     /// \brief Scene requester to get scene info
     public: SceneManager sceneManager;
 
@@ -880,8 +900,16 @@ void IgnRenderer::HandleMouseEvent()
 
   if (this->dataPtr->mouseEvent.Type() == ignition::common::MouseEvent::SCROLL)
   {
-    this->dataPtr->target =
-        this->ScreenToScene(this->dataPtr->mouseEvent.Pos());
+    // Zooming moves the camera along the ray to the target, so the target
+    // stays under the mouse until it moves and is only picked again then
+    if (!this->dataPtr->scrollTargetValid ||
+        this->dataPtr->scrollPos != this->dataPtr->mouseEvent.Pos())
+    {
+      this->dataPtr->target =
+          this->ScreenToScene(this->dataPtr->mouseEvent.Pos());
+      this->dataPtr->scrollPos = this->dataPtr->mouseEvent.Pos();
+      this->dataPtr->scrollTargetValid = true;
+    }
     this->dataPtr->viewControl.SetTarget(this->dataPtr->target);
     double distance = this->dataPtr->camera->WorldPosition().Distance(
         this->dataPtr->target);
@@ -890,11 +918,22 @@ void IgnRenderer::HandleMouseEvent()
   }
   else
   {
-    if (this->dataPtr->drag == ignition::math::Vector2d::Zero)
+    this->dataPtr->scrollTargetValid = false;
+
+    // Pick once per press, the visual is kept for the click on release
+    if (this->dataPtr->pressPending)
     {
       this->dataPtr->target = this->ScreenToScene(
-          this->dataPtr->mouseEvent.PressPos());
+          this->dataPtr->mouseEvent.PressPos(), &this->dataPtr->pressVisual);
       this->dataPtr->viewControl.SetTarget(this->dataPtr->target);
+      this->dataPtr->pressPending = false;
+    }
+
+    if (this->dataPtr->clickPending)
+    {
+      this->SelectVisual(this->dataPtr->pressVisual);
+      this->dataPtr->pressVisual.reset();
+      this->dataPtr->clickPending = false;
     }
 
     // Pan with left button
@@ -924,6 +963,42 @@ void IgnRenderer::HandleMouseEvent()
   this->dataPtr->mouseDirty = false;
 }
 
+/////////////////////////////////////////////////
+void IgnRenderer::SelectVisual(
+    const ignition::rendering::VisualPtr &_visual) const
+{
+  if (!ignition::gui::App())
+    return;
+
+  // Select the top level visual, for a tesseract environment this is the link
+  // of the geometry or wire box that was clicked
+  ignition::rendering::VisualPtr visual = _visual;
+  unsigned int rootId = this->dataPtr->camera->Scene()->RootVisual()->Id();
+  while (visual)
+  {
+    auto parent =
+        std::dynamic_pointer_cast<ignition::rendering::Visual>(visual->Parent());
+    if (!parent || parent->Id() == rootId)
+      break;
+    visual = parent;
+  }
+
+  // The shader grid plane covers the whole view, clicking it is clicking
+  // empty space
+  auto mainWindow = ignition::gui::App()->findChild<ignition::gui::MainWindow *>();
+  if (visual && visual->Name() != GRID_SHADER_VISUAL_NAME)
+  {
+    ignition::gui::App()->sendEvent(mainWindow,
+        new tesseract_ignition::gui::events::EntitiesSelected(
+            {visual->Id()}, true));
+  }
+  else
+  {
+    ignition::gui::App()->sendEvent(mainWindow,
+        new tesseract_ignition::gui::events::DeselectAllEntities(true));
+  }
+}
+
 /////////////////////////////////////////////////
 void IgnRenderer::Initialize()
 {
@@ -1017,11 +1092,31 @@ void IgnRenderer::NewMouseEvent(const ignition::common::MouseEvent &_e,
   this->dataPtr->mouseEvent = _e;
   this->dataPtr->drag += _drag;
   this->dataPtr->mouseDirty = true;
+
+  // Events are merged until the next frame, so remember the presses and
+  // clicks which would otherwise be overwritten by a following event
+  if (_e.Type() == ignition::common::MouseEvent::PRESS)
+  {
+    this->dataPtr->pressPending = true;
+    this->dataPtr->pressDragged = false;
+  }
+  else if (_e.Type() == ignition::common::MouseEvent::MOVE &&
+           _drag != ignition::math::Vector2d::Zero)
+  {
+    this->dataPtr->pressDragged = true;
+  }
+  else if (_e.Type() == ignition::common::MouseEvent::RELEASE &&
+           _e.Button() == ignition::common::MouseEvent::LEFT &&
+           !this->dataPtr->pressDragged)
+  {
+    this->dataPtr->clickPending = true;
+  }
 }
 
 /////////////////////////////////////////////////
 ignition::math::Vector3d IgnRenderer::ScreenToScene(
-    const ignition::math::Vector2i &_screenPos) const
+    const ignition::math::Vector2i &_screenPos,
+    ignition::rendering::VisualPtr *_visual) const
 {
   // Normalize point on the image
   double width = this->dataPtr->camera->ImageWidth();
@@ -1030,17 +1125,44 @@ ignition::math::Vector3d IgnRenderer::ScreenToScene(
   double nx = 2.0 * _screenPos.X() / width - 1.0;
   double ny = 1.0 - 2.0 * _screenPos.Y() / height;
 
-  // Make a ray query
+  // Only computes the ray, the scene is not queried until ClosestPoint
   this->dataPtr->rayQuery->SetFromCamera(
       this->dataPtr->camera, ignition::math::Vector2d(nx, ny));
-
-  auto result = this->dataPtr->rayQuery->ClosestPoint();
-  if (result)
-    return result.point;
+  ignition::math::Vector3d origin = this->dataPtr->rayQuery->Origin();
+  ignition::math::Vector3d direction = this->dataPtr->rayQuery->Direction();
 
   // Set point to be 10m away if no intersection found
-  return this->dataPtr->rayQuery->Origin() +
-      this->dataPtr->rayQuery->Direction() * 10;
+  ignition::rendering::VisualPtr visual;
+  ignition::math::Vector3d point = origin + direction * 10;
+  if (this->picking == "ray_query")
+  {
+    auto result = this->dataPtr->rayQuery->ClosestPoint();
+    if (result)
+    {
+      point = result.point;
+      visual = this->dataPtr->camera->Scene()->VisualById(result.objectId);
+    }
+  }
+  else
+  {
+    // The camera renders the visual ids to an offscreen selection buffer and
+    // reads back the pixel under the mouse
+    visual = this->dataPtr->camera->VisualAt(_screenPos);
+    if (visual)
+    {
+      auto hit = visual->BoundingBox().Intersect(origin, direction, 0,
+          this->dataPtr->camera->FarClipPlane());
+      if (std::get<0>(hit))
+        point = std::get<2>(hit);
+      else
+        point = origin + direction * origin.Distance(visual->WorldPosition());
+    }
+  }
+
+  if (_visual)
+    *_visual = visual;
+
+  return point;
 }
 
 /////////////////////////////////////////////////
@@ -1297,6 +1419,12 @@ void RenderWindowItem::SetCameraPose(const ignition::math::Pose3d &_pose)
   this->dataPtr->renderThread->ignRenderer.cameraPose = _pose;
 }
 
+/////////////////////////////////////////////////
+void RenderWindowItem::SetPicking(const std::string &_picking)
+{
+  this->dataPtr->renderThread->ignRenderer.picking = _picking;
+}
+
 /////////////////////////////////////////////////
 void RenderWindowItem::SetPoseTopic(const std::string &_topic)
 {
@@ -1396,6 +1524,16 @@ void TesseractScene3D::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
       renderWindow->SetCameraPose(pose);
     }
 
+    if (auto elem = _pluginElem->FirstChildElement("picking"))
+    {
+      std::string picking = elem->GetText();
+      if (picking == "selection_buffer" || picking == "ray_query")
+        renderWindow->SetPicking(picking);
+      else
+        ignerr << "Unknown picking [" << picking << "], expected "
+               << "selection_buffer or ray_query" << std::endl;
+    }
+
     if (auto elem = _pluginElem->FirstChildElement("pose_topic"))
     {
       std::string topic = elem->GetText();
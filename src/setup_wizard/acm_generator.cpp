@@ -0,0 +1,981 @@
+/**
+ * @file acm_generator.cpp
+ * @brief Utilities for generating the Allowed Collision Matrix by sampling the environment
+ *
+ * @author Levi Armstrong
+ * @date October 18, 2026
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @copyright Copyright (c) 2020, Southwest Research Institute
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_ignition/setup_wizard/acm_generator.h>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <fstream>
+#include <memory>
+#include <limits>
+#include <random>
+#include <tesseract_common/types.h>
+#include <tesseract_geometry/geometries.h>
+
+namespace tesseract_ignition
+{
+
+ACMContactCounts::ACMContactCounts(std::vector<std::string> link_names)
+  : link_names_(std::move(link_names))
+{
+  link_indices_.reserve(link_names_.size());
+  for (std::size_t i = 0; i < link_names_.size(); ++i)
+    link_indices_[link_names_[i]] = i;
+
+  std::size_t n = link_names_.size();
+  std::size_t pair_count = (n < 2) ? 0 : (n * (n - 1)) / 2;
+  hits_.assign(pair_count, 0);
+  samples_.assign(pair_count, 0);
+  classes_.assign(pair_count, ACMPairClass::UNSETTLED);
+  link_unsettled_.assign(n, (n < 2) ? 0 : n - 1);
+  unsettled_ = pair_count;
+}
+
+const std::vector<std::string>& ACMContactCounts::getLinkNames() const { return link_names_; }
+
+std::size_t ACMContactCounts::getPairCount() const { return hits_.size(); }
+
+long ACMContactCounts::getLinkIndex(const std::string& link_name) const
+{
+  auto it = link_indices_.find(link_name);
+  if (it == link_indices_.end())
+    return -1;
+
+  return static_cast<long>(it->second);
+}
+
+std::size_t ACMContactCounts::getPairIndex(std::size_t i, std::size_t j) const
+{
+  assert(i != j);
+  if (i > j)
+    std::swap(i, j);
+
+  // Row offset of the upper triangular matrix without the diagonal
+  std::size_t n = link_names_.size();
+  return (i * n) - ((i * (i + 1)) / 2) + (j - i - 1);
+}
+
+void ACMContactCounts::addSample(const tesseract_collision::ContactResultMap& results)
+{
+  for (std::size_t p = 0; p < samples_.size(); ++p)
+  {
+    if (classes_[p] == ACMPairClass::UNSETTLED)
+      ++samples_[p];
+  }
+
+  for (const auto& pair : results)
+  {
+    if (pair.second.empty())
+      continue;
+
+    long i = getLinkIndex(pair.first.first);
+    long j = getLinkIndex(pair.first.second);
+    if (i < 0 || j < 0 || i == j)
+      continue;
+
+    std::size_t p = getPairIndex(static_cast<std::size_t>(i), static_cast<std::size_t>(j));
+    if (classes_[p] == ACMPairClass::UNSETTLED)
+      ++hits_[p];
+  }
+}
+
+std::uint32_t ACMContactCounts::getSamples(std::size_t pair_index) const { return samples_[pair_index]; }
+
+std::uint32_t ACMContactCounts::getHits(std::size_t pair_index) const { return hits_[pair_index]; }
+
+ACMPairClass ACMContactCounts::getPairClass(std::size_t pair_index) const { return classes_[pair_index]; }
+
+bool ACMContactCounts::isSettled(std::size_t pair_index) const
+{
+  return classes_[pair_index] != ACMPairClass::UNSETTLED;
+}
+
+bool ACMContactCounts::isSettled(const std::string& link_name1, const std::string& link_name2) const
+{
+  long i = getLinkIndex(link_name1);
+  long j = getLinkIndex(link_name2);
+  if (i < 0 || j < 0 || i == j)
+    return true;
+
+  return isSettled(getPairIndex(static_cast<std::size_t>(i), static_cast<std::size_t>(j)));
+}
+
+void ACMContactCounts::addSamples(std::size_t pair_index, std::uint32_t hits, std::uint32_t samples)
+{
+  assert(hits <= samples);
+  hits_[pair_index] += hits;
+  samples_[pair_index] += samples;
+}
+
+void ACMContactCounts::setPairClass(std::size_t pair_index, ACMPairClass pair_class)
+{
+  if (classes_[pair_index] == pair_class)
+    return;
+
+  // Keep track of the number of unsettled pairs per link so links can be deactivated once all their pairs settle
+  int change = 0;
+  if (classes_[pair_index] == ACMPairClass::UNSETTLED)
+    change = -1;
+  else if (pair_class == ACMPairClass::UNSETTLED)
+    change = 1;
+
+  classes_[pair_index] = pair_class;
+  if (change == 0)
+    return;
+
+  // Recover the link indices from the flat index
+  std::size_t n = link_names_.size();
+  std::size_t i = 0;
+  std::size_t row_start = 0;
+  while (pair_index >= row_start + (n - i - 1))
+  {
+    row_start += (n - i - 1);
+    ++i;
+  }
+  std::size_t j = i + 1 + (pair_index - row_start);
+
+  if (change < 0)
+  {
+    --unsettled_;
+    --link_unsettled_[i];
+    --link_unsettled_[j];
+  }
+  else
+  {
+    ++unsettled_;
+    ++link_unsettled_[i];
+    ++link_unsettled_[j];
+  }
+}
+
+std::size_t ACMContactCounts::getUnsettledPairCount() const { return unsettled_; }
+
+std::size_t ACMContactCounts::getUnsettledPairCount(std::size_t link_index) const
+{
+  return link_unsettled_[link_index];
+}
+
+/** @brief The two sided standard normal quantile for a confidence level */
+static double normalQuantile(double confidence)
+{
+  // Solve 1 - erfc(z / sqrt(2)) = confidence by bisection, this is only done once per generation
+  double lower = 0;
+  double upper = 10;
+  for (int i = 0; i < 100; ++i)
+  {
+    double z = 0.5 * (lower + upper);
+    if (1.0 - std::erfc(z / std::sqrt(2.0)) < confidence)
+      lower = z;
+    else
+      upper = z;
+  }
+  return 0.5 * (lower + upper);
+}
+
+HaltonSequence::HaltonSequence(std::size_t dimensions, std::uint32_t seed, std::uint64_t start_index)
+  : index_(start_index)
+{
+  bases_.reserve(dimensions);
+  for (std::uint32_t candidate = 2; bases_.size() < dimensions; ++candidate)
+  {
+    bool is_prime = true;
+    for (std::uint32_t prime : bases_)
+    {
+      if (prime * prime > candidate)
+        break;
+
+      if (candidate % prime == 0)
+      {
+        is_prime = false;
+        break;
+      }
+    }
+
+    if (is_prime)
+      bases_.push_back(candidate);
+  }
+
+  // The engine output is fully specified by the standard, the distributions are not, so they are avoided here
+  std::mt19937 engine(seed);
+  permutations_.reserve(dimensions);
+  for (std::uint32_t base : bases_)
+  {
+    // Zero is kept in place so the trailing zero digits do not change the value
+    std::vector<std::uint32_t> permutation(base);
+    for (std::uint32_t d = 0; d < base; ++d)
+      permutation[d] = d;
+
+    for (std::uint32_t d = base - 1; d > 1; --d)
+      std::swap(permutation[d], permutation[1 + (engine() % d)]);
+
+    permutations_.push_back(std::move(permutation));
+  }
+}
+
+Eigen::VectorXd HaltonSequence::next()
+{
+  // The first point of the sequence is the origin, so it is skipped
+  ++index_;
+
+  Eigen::VectorXd point(static_cast<Eigen::Index>(bases_.size()));
+  for (std::size_t d = 0; d < bases_.size(); ++d)
+  {
+    const std::vector<std::uint32_t>& permutation = permutations_[d];
+    double inv_base = 1.0 / bases_[d];
+    double scale = inv_base;
+    double value = 0;
+    for (std::uint64_t i = index_; i > 0; i /= bases_[d])
+    {
+      value += permutation[i % bases_[d]] * scale;
+      scale *= inv_base;
+    }
+    point(static_cast<Eigen::Index>(d)) = std::min(value, std::nextafter(1.0, 0.0));
+  }
+
+  return point;
+}
+
+std::uint64_t HaltonSequence::getIndex() const { return index_; }
+
+bool ACMGeneratorCache::load(const std::string& filepath)
+{
+  entries_.clear();
+  std::ifstream file(filepath);
+  if (!file.is_open())
+    return false;
+
+  std::string header;
+  int version {0};
+  if (!(file >> header >> version) || header != "tesseract_ignition_acm_cache" || version != 2)
+    return false;
+
+  std::uint64_t key {0};
+  ACMCacheEntry entry;
+  while (file >> std::hex >> key >> std::dec >> entry.hits >> entry.samples >> entry.sequence_end)
+  {
+    if (entry.hits <= entry.samples)
+      entries_[key] = entry;
+  }
+
+  return true;
+}
+
+bool ACMGeneratorCache::save(const std::string& filepath) const
+{
+  std::ofstream file(filepath, std::ios::trunc);
+  if (!file.is_open())
+    return false;
+
+  file << "tesseract_ignition_acm_cache 2\n";
+  for (const auto& entry : entries_)
+  {
+    file << std::hex << entry.first << std::dec << " " << entry.second.hits << " " << entry.second.samples << " "
+         << entry.second.sequence_end << "\n";
+  }
+
+  return file.good();
+}
+
+const ACMCacheEntry* ACMGeneratorCache::find(std::uint64_t key) const
+{
+  auto it = entries_.find(key);
+  if (it == entries_.end())
+    return nullptr;
+
+  return &(it->second);
+}
+
+void ACMGeneratorCache::store(std::uint64_t key, const ACMCacheEntry& entry) { entries_[key] = entry; }
+
+std::size_t ACMGeneratorCache::size() const { return entries_.size(); }
+
+void ACMGeneratorCache::clear() { entries_.clear(); }
+
+namespace
+{
+/** @brief 64 bit FNV-1a hash, chosen because it is stable across platforms and runs unlike std::hash */
+class FNVHash
+{
+public:
+  void add(const void* data, std::size_t size)
+  {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      hash_ ^= bytes[i];
+      hash_ *= 1099511628211ULL;
+    }
+  }
+
+  void add(double value)
+  {
+    // Make sure negative zero hashes the same as zero
+    if (value == 0)
+      value = 0;
+    add(&value, sizeof(value));
+  }
+
+  void add(int value) { add(&value, sizeof(value)); }
+
+  void add(const std::string& value)
+  {
+    add(static_cast<int>(value.size()));
+    add(value.data(), value.size());
+  }
+
+  void add(const Eigen::Isometry3d& transform)
+  {
+    for (Eigen::Index i = 0; i < 3; ++i)
+      for (Eigen::Index j = 0; j < 4; ++j)
+        add(transform.matrix()(i, j));
+  }
+
+  void add(const Eigen::Vector3d& vector)
+  {
+    for (Eigen::Index i = 0; i < 3; ++i)
+      add(vector(i));
+  }
+
+  void add(const tesseract_common::VectorVector3d& vertices)
+  {
+    add(static_cast<int>(vertices.size()));
+    for (const auto& v : vertices)
+      add(v);
+  }
+
+  /** @brief Add the triangle or face indices of a mesh */
+  void add(const Eigen::VectorXi& indices)
+  {
+    add(static_cast<int>(indices.size()));
+    add(indices.data(), static_cast<std::size_t>(indices.size()) * sizeof(int));
+  }
+
+  std::uint64_t get() const { return hash_; }
+
+private:
+  std::uint64_t hash_ {14695981039346656037ULL};
+};
+
+/** @brief Add a geometry to the hash, returns false if the geometry type is not supported */
+bool addGeometryHash(FNVHash& hash, const tesseract_geometry::Geometry& geometry)
+{
+  hash.add(static_cast<int>(geometry.getType()));
+  switch (geometry.getType())
+  {
+    case tesseract_geometry::GeometryType::BOX:
+    {
+      const auto& box = static_cast<const tesseract_geometry::Box&>(geometry);
+      hash.add(box.getX());
+      hash.add(box.getY());
+      hash.add(box.getZ());
+      return true;
+    }
+    case tesseract_geometry::GeometryType::SPHERE:
+    {
+      hash.add(static_cast<const tesseract_geometry::Sphere&>(geometry).getRadius());
+      return true;
+    }
+    case tesseract_geometry::GeometryType::CYLINDER:
+    {
+      const auto& cylinder = static_cast<const tesseract_geometry::Cylinder&>(geometry);
+      hash.add(cylinder.getRadius());
+      hash.add(cylinder.getLength());
+      return true;
+    }
+    case tesseract_geometry::GeometryType::CAPSULE:
+    {
+      const auto& capsule = static_cast<const tesseract_geometry::Capsule&>(geometry);
+      hash.add(capsule.getRadius());
+      hash.add(capsule.getLength());
+      return true;
+    }
+    case tesseract_geometry::GeometryType::CONE:
+    {
+      const auto& cone = static_cast<const tesseract_geometry::Cone&>(geometry);
+      hash.add(cone.getRadius());
+      hash.add(cone.getLength());
+      return true;
+    }
+    case tesseract_geometry::GeometryType::MESH:
+    {
+      const auto& mesh = static_cast<const tesseract_geometry::Mesh&>(geometry);
+      hash.add(mesh.getScale());
+      hash.add(*mesh.getVertices());
+      hash.add(*mesh.getTriangles());
+      return true;
+    }
+    case tesseract_geometry::GeometryType::CONVEX_MESH:
+    {
+      const auto& mesh = static_cast<const tesseract_geometry::ConvexMesh&>(geometry);
+      hash.add(mesh.getScale());
+      hash.add(*mesh.getVertices());
+      hash.add(*mesh.getFaces());
+      return true;
+    }
+    case tesseract_geometry::GeometryType::SDF_MESH:
+    {
+      const auto& mesh = static_cast<const tesseract_geometry::SDFMesh&>(geometry);
+      hash.add(mesh.getScale());
+      hash.add(*mesh.getVertices());
+      hash.add(*mesh.getTriangles());
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+}  // namespace
+
+std::uint64_t getLinkCacheHash(const tesseract_scene_graph::SceneGraph& scene_graph, const std::string& link_name)
+{
+  FNVHash hash;
+  hash.add(link_name);
+  for (const auto& collision : scene_graph.getLink(link_name)->collision)
+  {
+    hash.add(collision->origin);
+    if (!addGeometryHash(hash, *collision->geometry))
+      return 0;
+  }
+
+  std::string current = link_name;
+  std::vector<tesseract_scene_graph::Joint::ConstPtr> joints = scene_graph.getInboundJoints(current);
+  while (!joints.empty())
+  {
+    const tesseract_scene_graph::Joint& joint = *joints[0];
+    hash.add(joint.parent_link_name);
+    hash.add(static_cast<int>(joint.type));
+    hash.add(joint.parent_to_joint_origin_transform);
+    hash.add(joint.axis);
+    if (joint.limits != nullptr)
+    {
+      hash.add(joint.limits->lower);
+      hash.add(joint.limits->upper);
+    }
+
+    current = joint.parent_link_name;
+    joints = scene_graph.getInboundJoints(current);
+  }
+
+  // Zero is reserved for links which cannot be cached
+  std::uint64_t value = hash.get();
+  return (value == 0) ? 1 : value;
+}
+
+std::uint64_t getPairCacheKey(std::uint64_t link_hash1,
+                              std::uint64_t link_hash2,
+                              double contact_distance,
+                              const ACMGeneratorConfig& config)
+{
+  if (link_hash1 == 0 || link_hash2 == 0)
+    return 0;
+
+  // The key must not depend on the order of the links
+  if (link_hash1 > link_hash2)
+    std::swap(link_hash1, link_hash2);
+
+  FNVHash hash;
+  hash.add(&link_hash1, sizeof(link_hash1));
+  hash.add(&link_hash2, sizeof(link_hash2));
+  hash.add(contact_distance);
+
+  // Samples from different sequences are not combined, the seed only changes the Halton sequence
+  hash.add(static_cast<int>(config.sampling_mode));
+  if (config.sampling_mode == ACMSamplingMode::HALTON)
+    hash.add(static_cast<int>(config.sampling_seed));
+
+  std::uint64_t value = hash.get();
+  return (value == 0) ? 1 : value;
+}
+
+ACMPairClass settlePairClass(std::uint32_t hits, std::uint32_t samples, const ACMGeneratorConfig& config)
+{
+  if (config.confidence <= 0 || config.confidence >= 1 || samples == 0 ||
+      static_cast<long>(samples) < config.min_samples)
+    return ACMPairClass::UNSETTLED;
+
+  double n = samples;
+  if (hits == 0)
+  {
+    // Exact one sided upper bound of the contact probability when no contact was observed. A pair only gets here
+    // while it has never been in contact, so this passes at a single sample count and needs no correction for being
+    // checked after every sample.
+    double upper = 1.0 - std::pow(1.0 - config.confidence, 1.0 / n);
+    return (upper < config.never_tolerance) ? ACMPairClass::NEVER : ACMPairClass::UNSETTLED;
+  }
+
+  // The interval is only checked at min_samples times a power of two. The error allowed at look k is
+  // (1 - confidence) / 2^(k + 1), which sums to at most 1 - confidence over all looks.
+  auto first_look = static_cast<std::uint32_t>(std::max(config.min_samples, 1L));
+  if (samples % first_look != 0)
+    return ACMPairClass::UNSETTLED;
+
+  std::uint32_t multiple = samples / first_look;
+  if ((multiple & (multiple - 1)) != 0)
+    return ACMPairClass::UNSETTLED;
+
+  std::size_t look = 0;
+  while ((1U << look) < multiple)
+    ++look;
+
+  static thread_local double cached_confidence {-1};
+  static thread_local std::vector<double> look_z;
+  if (cached_confidence != config.confidence)
+  {
+    look_z.clear();
+    cached_confidence = config.confidence;
+  }
+
+  while (look_z.size() <= look)
+    look_z.push_back(normalQuantile(1.0 - (1.0 - config.confidence) / std::pow(2.0, double(look_z.size() + 1))));
+
+  double z = look_z[look];
+
+  // Wilson score interval
+  double p = double(hits) / n;
+  double z2 = z * z;
+  double center = (p + z2 / (2.0 * n)) / (1.0 + z2 / n);
+  double half_width = (z / (1.0 + z2 / n)) * std::sqrt((p * (1.0 - p) / n) + (z2 / (4.0 * n * n)));
+
+  if (center - half_width > config.always_threshold)
+    return ACMPairClass::ALWAYS;
+
+  if (center + half_width < config.always_threshold)
+    return ACMPairClass::SOMETIMES;
+
+  return ACMPairClass::UNSETTLED;
+}
+
+ACMPairClass estimatePairClass(std::uint32_t hits, std::uint32_t samples, const ACMGeneratorConfig& config)
+{
+  if (hits == 0)
+    return ACMPairClass::NEVER;
+
+  if (samples > 0 && (double(hits) / double(samples)) > config.always_threshold)
+    return ACMPairClass::ALWAYS;
+
+  return ACMPairClass::SOMETIMES;
+}
+
+namespace
+{
+/** @brief A bounding sphere, an infinite radius means the volume is unbounded */
+struct BoundingSphere
+{
+  Eigen::Vector3d center {Eigen::Vector3d::Zero()};
+  double radius {0};
+};
+
+/** @brief The bounding sphere of the scaled vertices of a mesh, centered on their bounding box */
+BoundingSphere getVerticesBoundingSphere(const tesseract_common::VectorVector3d& vertices, const Eigen::Vector3d& scale)
+{
+  BoundingSphere sphere;
+  if (vertices.empty())
+    return sphere;
+
+  Eigen::Vector3d min = vertices[0].cwiseProduct(scale);
+  Eigen::Vector3d max = min;
+  for (const auto& v : vertices)
+  {
+    Eigen::Vector3d sv = v.cwiseProduct(scale);
+    min = min.cwiseMin(sv);
+    max = max.cwiseMax(sv);
+  }
+
+  sphere.center = 0.5 * (min + max);
+  for (const auto& v : vertices)
+    sphere.radius = std::max(sphere.radius, (v.cwiseProduct(scale) - sphere.center).norm());
+
+  return sphere;
+}
+
+/** @brief The bounding sphere of a geometry in its own frame */
+BoundingSphere getGeometryBoundingSphere(const tesseract_geometry::Geometry& geometry)
+{
+  BoundingSphere sphere;
+  switch (geometry.getType())
+  {
+    case tesseract_geometry::GeometryType::BOX:
+    {
+      const auto& box = static_cast<const tesseract_geometry::Box&>(geometry);
+      sphere.radius = 0.5 * Eigen::Vector3d(box.getX(), box.getY(), box.getZ()).norm();
+      break;
+    }
+    case tesseract_geometry::GeometryType::SPHERE:
+    {
+      sphere.radius = static_cast<const tesseract_geometry::Sphere&>(geometry).getRadius();
+      break;
+    }
+    case tesseract_geometry::GeometryType::CYLINDER:
+    {
+      const auto& cylinder = static_cast<const tesseract_geometry::Cylinder&>(geometry);
+      sphere.radius = std::sqrt(std::pow(cylinder.getRadius(), 2) + std::pow(0.5 * cylinder.getLength(), 2));
+      break;
+    }
+    case tesseract_geometry::GeometryType::CAPSULE:
+    {
+      const auto& capsule = static_cast<const tesseract_geometry::Capsule&>(geometry);
+      sphere.radius = capsule.getRadius() + 0.5 * capsule.getLength();
+      break;
+    }
+    case tesseract_geometry::GeometryType::CONE:
+    {
+      const auto& cone = static_cast<const tesseract_geometry::Cone&>(geometry);
+      sphere.radius = std::sqrt(std::pow(cone.getRadius(), 2) + std::pow(0.5 * cone.getLength(), 2));
+      break;
+    }
+    case tesseract_geometry::GeometryType::MESH:
+    {
+      const auto& mesh = static_cast<const tesseract_geometry::Mesh&>(geometry);
+      sphere = getVerticesBoundingSphere(*mesh.getVertices(), mesh.getScale());
+      break;
+    }
+    case tesseract_geometry::GeometryType::CONVEX_MESH:
+    {
+      const auto& mesh = static_cast<const tesseract_geometry::ConvexMesh&>(geometry);
+      sphere = getVerticesBoundingSphere(*mesh.getVertices(), mesh.getScale());
+      break;
+    }
+    case tesseract_geometry::GeometryType::SDF_MESH:
+    {
+      const auto& mesh = static_cast<const tesseract_geometry::SDFMesh&>(geometry);
+      sphere = getVerticesBoundingSphere(*mesh.getVertices(), mesh.getScale());
+      break;
+    }
+    default:
+    {
+      // Planes, octrees and unknown geometries are treated as unbounded
+      sphere.radius = std::numeric_limits<double>::infinity();
+    }
+  }
+  return sphere;
+}
+
+/** @brief The bounding sphere of all the collision geometries of a link in the link frame */
+BoundingSphere getLinkBoundingSphere(const tesseract_scene_graph::Link& link)
+{
+  std::vector<BoundingSphere> spheres;
+  spheres.reserve(link.collision.size());
+  Eigen::Vector3d min = Eigen::Vector3d::Constant(std::numeric_limits<double>::max());
+  Eigen::Vector3d max = Eigen::Vector3d::Constant(std::numeric_limits<double>::lowest());
+  for (const auto& collision : link.collision)
+  {
+    BoundingSphere sphere = getGeometryBoundingSphere(*collision->geometry);
+    sphere.center = collision->origin * sphere.center;
+    if (std::isinf(sphere.radius))
+      return sphere;
+
+    min = min.cwiseMin(sphere.center - Eigen::Vector3d::Constant(sphere.radius));
+    max = max.cwiseMax(sphere.center + Eigen::Vector3d::Constant(sphere.radius));
+    spheres.push_back(sphere);
+  }
+
+  BoundingSphere link_sphere;
+  if (spheres.empty())
+    return link_sphere;
+
+  link_sphere.center = 0.5 * (min + max);
+  for (const auto& sphere : spheres)
+    link_sphere.radius = std::max(link_sphere.radius, (sphere.center - link_sphere.center).norm() + sphere.radius);
+
+  return link_sphere;
+}
+
+/**
+ * @brief Move a sphere given in the child link frame of a joint to the parent link frame, growing it so it bounds
+ * every position the joint can put it in
+ */
+BoundingSphere sweepBoundingSphere(const BoundingSphere& sphere, const tesseract_scene_graph::Joint& joint)
+{
+  BoundingSphere swept = sphere;
+  if (std::isinf(swept.radius))
+    return swept;
+
+  Eigen::Vector3d axis = joint.axis.normalized();
+  switch (joint.type)
+  {
+    case tesseract_scene_graph::JointType::FIXED:
+      break;
+    case tesseract_scene_graph::JointType::REVOLUTE:
+    case tesseract_scene_graph::JointType::CONTINUOUS:
+    {
+      // The center travels on a circle around the axis, so center the sphere on the axis
+      Eigen::Vector3d on_axis = axis * axis.dot(sphere.center);
+      swept.center = on_axis;
+      swept.radius = sphere.radius + (sphere.center - on_axis).norm();
+      break;
+    }
+    case tesseract_scene_graph::JointType::PRISMATIC:
+    {
+      double lower = (joint.limits != nullptr) ? joint.limits->lower : 0;
+      double upper = (joint.limits != nullptr) ? joint.limits->upper : 0;
+      swept.center = sphere.center + axis * (0.5 * (lower + upper));
+      swept.radius = sphere.radius + 0.5 * std::abs(upper - lower);
+      break;
+    }
+    default:
+    {
+      // Floating and planar joints are unbounded
+      swept.radius = std::numeric_limits<double>::infinity();
+      return swept;
+    }
+  }
+
+  swept.center = joint.parent_to_joint_origin_transform * swept.center;
+  return swept;
+}
+
+/** @brief The swept bounding spheres of a link expressed in the frame of each of its ancestors */
+struct SweptLinkBounds
+{
+  /** @brief Ancestor link name to index in spheres, the link itself is at index zero */
+  std::unordered_map<std::string, std::size_t> ancestors;
+
+  /** @brief The ancestor link names ordered from the link to the root */
+  std::vector<std::string> ancestor_names;
+
+  /** @brief The bounding sphere of the link over the motion of all joints up to the ancestor */
+  std::vector<BoundingSphere> spheres;
+};
+
+SweptLinkBounds getSweptLinkBounds(const tesseract_scene_graph::SceneGraph& scene_graph, const std::string& link_name)
+{
+  SweptLinkBounds bounds;
+  BoundingSphere sphere = getLinkBoundingSphere(*scene_graph.getLink(link_name));
+  std::string current = link_name;
+  while (true)
+  {
+    bounds.ancestors[current] = bounds.spheres.size();
+    bounds.ancestor_names.push_back(current);
+    bounds.spheres.push_back(sphere);
+
+    std::vector<tesseract_scene_graph::Joint::ConstPtr> joints = scene_graph.getInboundJoints(current);
+    if (joints.empty())
+      break;
+
+    sphere = sweepBoundingSphere(sphere, *joints[0]);
+    current = joints[0]->parent_link_name;
+  }
+  return bounds;
+}
+}  // namespace
+
+std::size_t settleUnreachablePairs(const tesseract_scene_graph::SceneGraph& scene_graph,
+                                   ACMContactCounts& counts,
+                                   double margin)
+{
+  const std::vector<std::string>& link_names = counts.getLinkNames();
+  std::vector<SweptLinkBounds> bounds;
+  bounds.reserve(link_names.size());
+  for (const auto& link_name : link_names)
+    bounds.push_back(getSweptLinkBounds(scene_graph, link_name));
+
+  std::size_t settled = 0;
+  for (std::size_t i = 0; i + 1 < link_names.size(); ++i)
+  {
+    for (std::size_t j = i + 1; j < link_names.size(); ++j)
+    {
+      std::size_t p = counts.getPairIndex(i, j);
+      if (counts.isSettled(p))
+        continue;
+
+      // Compare both links in the frame of their lowest common ancestor, which moves both of them equally
+      for (std::size_t a = 0; a < bounds[i].ancestor_names.size(); ++a)
+      {
+        auto it = bounds[j].ancestors.find(bounds[i].ancestor_names[a]);
+        if (it == bounds[j].ancestors.end())
+          continue;
+
+        const BoundingSphere& sphere1 = bounds[i].spheres[a];
+        const BoundingSphere& sphere2 = bounds[j].spheres[it->second];
+        if (!std::isinf(sphere1.radius) && !std::isinf(sphere2.radius) &&
+            (sphere1.center - sphere2.center).norm() > (sphere1.radius + sphere2.radius + margin))
+        {
+          counts.setPairClass(p, ACMPairClass::NEVER);
+          ++settled;
+        }
+        break;
+      }
+    }
+  }
+
+  return settled;
+}
+
+ACMContactCounts sampleContacts(const tesseract_environment::Environment& env,
+                                const ACMGeneratorConfig& config,
+                                ACMGeneratorCache* cache)
+{
+  std::vector<std::string> link_names;
+  for (const auto& link_name : env.getLinkNames())
+  {
+    if (!env.getLink(link_name)->collision.empty())
+      link_names.push_back(link_name);
+  }
+
+  ACMContactCounts counts(link_names);
+  if (link_names.size() < 2)
+    return counts;
+
+  auto contact_manager = env.getDiscreteContactManager();
+  auto state_solver = env.getStateSolver();
+  double contact_distance = contact_manager->getContactDistanceThreshold();
+
+  std::vector<std::uint64_t> pair_keys;
+  std::uint64_t sequence_start = 0;
+  if (cache != nullptr)
+  {
+    std::vector<std::uint64_t> link_hashes;
+    link_hashes.reserve(link_names.size());
+    for (const auto& link_name : link_names)
+      link_hashes.push_back(getLinkCacheHash(*env.getSceneGraph(), link_name));
+
+    // Pairs found in the cache start from their cached samples and are settled right away when those are enough
+    pair_keys.assign(counts.getPairCount(), 0);
+    for (std::size_t i = 0; i + 1 < link_names.size(); ++i)
+    {
+      for (std::size_t j = i + 1; j < link_names.size(); ++j)
+      {
+        std::size_t p = counts.getPairIndex(i, j);
+        pair_keys[p] = getPairCacheKey(link_hashes[i], link_hashes[j], contact_distance, config);
+        const ACMCacheEntry* entry = (pair_keys[p] != 0) ? cache->find(pair_keys[p]) : nullptr;
+        if (entry == nullptr)
+          continue;
+
+        counts.addSamples(p, entry->hits, entry->samples);
+        sequence_start = std::max(sequence_start, entry->sequence_end);
+        ACMPairClass pair_class = settlePairClass(entry->hits, entry->samples, config);
+        if (pair_class == ACMPairClass::UNSETTLED && static_cast<long>(entry->samples) >= config.resolution)
+          pair_class = estimatePairClass(entry->hits, entry->samples, config);
+
+        counts.setPairClass(p, pair_class);
+      }
+    }
+  }
+
+  if (config.prune_unreachable_pairs)
+    settleUnreachablePairs(*env.getSceneGraph(), counts, contact_distance);
+
+  // The environment's allowed collision matrix is ignored, instead pairs are skipped once they are settled
+  contact_manager->setIsContactAllowedFn([&counts](const std::string& link_name1, const std::string& link_name2) {
+    return counts.isSettled(link_name1, link_name2);
+  });
+  std::size_t active_count = link_names.size() + 1;
+
+  // The Halton sequence is mapped onto the limits of the active joints
+  std::vector<std::string> joint_names;
+  Eigen::VectorXd joint_lower;
+  Eigen::VectorXd joint_range;
+  std::unique_ptr<HaltonSequence> halton;
+  if (config.sampling_mode == ACMSamplingMode::HALTON)
+  {
+    joint_names = env.getActiveJointNames();
+    joint_lower.resize(static_cast<Eigen::Index>(joint_names.size()));
+    joint_range.resize(static_cast<Eigen::Index>(joint_names.size()));
+    for (std::size_t j = 0; j < joint_names.size(); ++j)
+    {
+      auto joint = env.getSceneGraph()->getJoint(joint_names[j]);
+      auto idx = static_cast<Eigen::Index>(j);
+      if (joint->type == tesseract_scene_graph::JointType::CONTINUOUS || joint->limits == nullptr)
+      {
+        joint_lower(idx) = -M_PI;
+        joint_range(idx) = 2 * M_PI;
+      }
+      else
+      {
+        joint_lower(idx) = joint->limits->lower;
+        joint_range(idx) = joint->limits->upper - joint->limits->lower;
+      }
+    }
+    // Continue after every cached sample, restarting would count the cached joint states a second time
+    halton = std::make_unique<HaltonSequence>(joint_names.size(), config.sampling_seed, sequence_start);
+  }
+
+  tesseract_collision::ContactResultMap results;
+  tesseract_collision::ContactRequest request;
+  request.type = tesseract_collision::ContactTestType::ALL;
+
+  for (long i = 0; i < config.resolution && counts.getUnsettledPairCount() > 0; ++i)
+  {
+    // A pair is checked when at least one of its links is active, so only links with no unsettled pairs are removed
+    std::vector<std::string> active_links;
+    active_links.reserve(link_names.size());
+    for (std::size_t l = 0; l < link_names.size(); ++l)
+    {
+      if (counts.getUnsettledPairCount(l) > 0)
+        active_links.push_back(link_names[l]);
+    }
+
+    if (active_links.size() != active_count)
+    {
+      active_count = active_links.size();
+      contact_manager->setActiveCollisionObjects(active_links);
+    }
+
+    tesseract_environment::EnvState::Ptr state;
+    if (halton != nullptr)
+      state = state_solver->getState(joint_names, joint_lower + joint_range.cwiseProduct(halton->next()));
+    else
+      state = state_solver->getRandomState();
+
+    contact_manager->setCollisionObjectsTransform(state->link_transforms);
+    contact_manager->contactTest(results, request);
+
+    // Only the pairs in contact are kept, the results are cleared so they do not pile up across samples
+    counts.addSample(results);
+    results.clear();
+
+    for (std::size_t p = 0; p < counts.getPairCount(); ++p)
+    {
+      if (!counts.isSettled(p))
+        counts.setPairClass(p, settlePairClass(counts.getHits(p), counts.getSamples(p), config));
+    }
+  }
+
+  for (std::size_t p = 0; p < counts.getPairCount(); ++p)
+  {
+    if (!counts.isSettled(p))
+      counts.setPairClass(p, estimatePairClass(counts.getHits(p), counts.getSamples(p), config));
+  }
+
+  if (cache != nullptr)
+  {
+    // Only the pairs of this generation are kept, so entries of links or geometry that changed do not pile up. Pairs
+    // settled by pruning have no samples and are cheap to settle again, so they are not stored.
+    cache->clear();
+
+    // The last index is stored for every pair, a pair settled earlier in the sequence has not used the later indices
+    // but skipping them is harmless
+    std::uint64_t sequence_end = (halton != nullptr) ? halton->getIndex() : 0;
+    for (std::size_t p = 0; p < counts.getPairCount(); ++p)
+    {
+      if (pair_keys[p] != 0 && counts.getSamples(p) > 0)
+        cache->store(pair_keys[p], { counts.getHits(p), counts.getSamples(p), sequence_end });
+    }
+  }
+
+  return counts;
+}
+
+}
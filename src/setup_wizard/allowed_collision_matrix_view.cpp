@@ -0,0 +1,218 @@
+/**
+ * @file allowed_collision_matrix_view.cpp
+ * @brief A Qt Quick item drawing the Tesseract Allowed Collision Matrix as a link by link matrix
+ *
+ * @author Levi Armstrong
+ * @date October 18, 2026
+ * @version TODO
+ * @bug No known bugs
+ *
+ *
+ * @copyright Copyright (c) 2020, Southwest Research Institute
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_ignition/setup_wizard/allowed_collision_matrix_view.h>
+#include <QPainter>
+#include <QMouseEvent>
+#include <cmath>
+
+namespace tesseract_ignition
+{
+
+AllowedCollisionMatrixView::AllowedCollisionMatrixView(QQuickItem *parent)
+  : QQuickPaintedItem(parent)
+{
+  setAcceptedMouseButtons(Qt::LeftButton);
+  setAntialiasing(false);
+}
+
+AllowedCollisionMatrixModel* AllowedCollisionMatrixView::model() const
+{
+  return model_;
+}
+
+void AllowedCollisionMatrixView::setModel(AllowedCollisionMatrixModel* model)
+{
+  if (model_ == model)
+    return;
+
+  if (model_)
+    disconnect(model_, nullptr, this, nullptr);
+
+  model_ = model;
+  if (model_)
+  {
+    connect(model_, &QAbstractItemModel::modelReset, this, &AllowedCollisionMatrixView::rebuild);
+    connect(model_, &QAbstractItemModel::rowsInserted, this, &AllowedCollisionMatrixView::onRowsChanged);
+    connect(model_, &QAbstractItemModel::rowsAboutToBeRemoved, this, &AllowedCollisionMatrixView::onRowsAboutToBeRemoved);
+    connect(model_, &QAbstractItemModel::dataChanged, this, &AllowedCollisionMatrixView::onDataChanged);
+  }
+
+  rebuild();
+  emit modelChanged();
+}
+
+int AllowedCollisionMatrixView::linkCount() const
+{
+  return link_names_.size();
+}
+
+QString AllowedCollisionMatrixView::linkName(int index) const
+{
+  if (index < 0 || index >= link_names_.size())
+    return QString();
+
+  return link_names_[index];
+}
+
+AllowedCollisionMatrixView::ReasonCode AllowedCollisionMatrixView::getReasonCode(const QString& reason)
+{
+  if (reason == "Adjacent")
+    return ADJACENT;
+
+  if (reason == "Never")
+    return NEVER;
+
+  // The generator writes Allways, both spellings are accepted
+  if (reason == "Allways" || reason == "Always")
+    return ALWAYS;
+
+  return USER;
+}
+
+void AllowedCollisionMatrixView::rebuild()
+{
+  int link_count = link_names_.size();
+  link_names_.clear();
+  link_indices_.clear();
+
+  tesseract_environment::Environment::ConstPtr env = (model_) ? model_->getEnvironment() : nullptr;
+  if (env != nullptr)
+  {
+    // Only links with collision geometry can be in the allowed collision matrix
+    for (const auto& link_name : env->getLinkNames())
+    {
+      if (!env->getLink(link_name)->collision.empty())
+      {
+        link_indices_[QString::fromStdString(link_name)] = link_names_.size();
+        link_names_.push_back(QString::fromStdString(link_name));
+      }
+    }
+  }
+
+  int n = link_names_.size();
+  matrix_ = QImage(n, n, QImage::Format_Indexed8);
+  matrix_.setColorTable({ qRgb(245, 245, 245),    // NONE
+                          qRgb(70, 130, 180),     // ADJACENT
+                          qRgb(60, 179, 113),     // NEVER
+                          qRgb(220, 20, 60),      // ALWAYS
+                          qRgb(255, 165, 0),      // USER
+                          qRgb(128, 128, 128) }); // DIAGONAL
+  matrix_.fill(static_cast<uint>(NONE));
+  for (int i = 0; i < n; ++i)
+    matrix_.setPixel(i, i, DIAGONAL);
+
+  if (model_)
+  {
+    for (const auto& entry : model_->getEntries())
+      setPairCode(entry.link1, entry.link2, getReasonCode(entry.reason));
+  }
+
+  if (link_count != n)
+    emit linkCountChanged();
+
+  update();
+}
+
+bool AllowedCollisionMatrixView::setPairCode(const QString& link1, const QString& link2, ReasonCode code)
+{
+  auto it1 = link_indices_.find(link1);
+  auto it2 = link_indices_.find(link2);
+  if (it1 == link_indices_.end() || it2 == link_indices_.end() || it1.value() == it2.value())
+    return false;
+
+  matrix_.setPixel(it1.value(), it2.value(), code);
+  matrix_.setPixel(it2.value(), it1.value(), code);
+  return true;
+}
+
+void AllowedCollisionMatrixView::onRowsChanged(const QModelIndex &parent, int first, int last)
+{
+  if (parent.isValid())
+    return;
+
+  const auto& entries = model_->getEntries();
+  for (int row = first; row <= last; ++row)
+  {
+    const auto& entry = entries[static_cast<std::size_t>(row)];
+    setPairCode(entry.link1, entry.link2, getReasonCode(entry.reason));
+  }
+  update();
+}
+
+void AllowedCollisionMatrixView::onRowsAboutToBeRemoved(const QModelIndex &parent, int first, int last)
+{
+  if (parent.isValid())
+    return;
+
+  const auto& entries = model_->getEntries();
+  for (int row = first; row <= last; ++row)
+  {
+    const auto& entry = entries[static_cast<std::size_t>(row)];
+    setPairCode(entry.link1, entry.link2, NONE);
+  }
+  update();
+}
+
+void AllowedCollisionMatrixView::onDataChanged(const QModelIndex &top_left, const QModelIndex &bottom_right)
+{
+  onRowsChanged(top_left.parent(), top_left.row(), bottom_right.row());
+}
+
+QRectF AllowedCollisionMatrixView::matrixRect() const
+{
+  qreal side = std::min(width(), height());
+  return QRectF((width() - side) / 2, (height() - side) / 2, side, side);
+}
+
+void AllowedCollisionMatrixView::paint(QPainter *painter)
+{
+  if (matrix_.isNull())
+    return;
+
+  // Nearest neighbour scaling keeps each pair a sharp cell
+  painter->setRenderHint(QPainter::SmoothPixmapTransform, false);
+  painter->drawImage(matrixRect(), matrix_);
+}
+
+void AllowedCollisionMatrixView::mousePressEvent(QMouseEvent *event)
+{
+  QRectF rect = matrixRect();
+  int n = link_names_.size();
+  if (n == 0 || !rect.contains(event->localPos()))
+  {
+    event->ignore();
+    return;
+  }
+
+  int i = std::min(n - 1, static_cast<int>(std::floor((event->localPos().y() - rect.top()) * n / rect.height())));
+  int j = std::min(n - 1, static_cast<int>(std::floor((event->localPos().x() - rect.left()) * n / rect.width())));
+  int row = (model_ && i != j) ? model_->find(link_names_[i], link_names_[j]) : -1;
+  emit pairClicked(link_names_[i], link_names_[j], row);
+  event->accept();
+}
+
+}
@@ -1,6 +1,6 @@
 /**
  * @file allowed_collision_matrix_model.cpp
- * @brief A Qt Standard Item Model for Tesseract Allowed Collision Matrix
+ * @brief A Qt Table Model for Tesseract Allowed Collision Matrix
  *
  * @author Levi Armstrong
  * @date May 14, 2020
@@ -25,23 +25,48 @@
  */
 #include <tesseract_ignition/setup_wizard/models/allowed_collision_matrix_model.h>
 
+#include <tesseract_environment/core/commands.h>
+#include <algorithm>
+#include <set>
+
 namespace tesseract_ignition
 {
 
+namespace
+{
+bool entryLess(const AllowedCollisionMatrixModel::Entry& entry, const std::pair<QString, QString>& pair)
+{
+  int cmp = entry.link1.compare(pair.first);
+  return (cmp < 0) || (cmp == 0 && entry.link2 < pair.second);
+}
+
+std::pair<QString, QString> makeOrderedPair(const QString& link_name1, const QString& link_name2)
+{
+  if (link_name2 < link_name1)
+    return std::make_pair(link_name2, link_name1);
+
+  return std::make_pair(link_name1, link_name2);
+}
+}
+
 AllowedCollisionMatrixModel::AllowedCollisionMatrixModel(QObject *parent)
-  : QStandardItemModel(parent)
+  : QAbstractTableModel(parent)
 {
 }
 
 AllowedCollisionMatrixModel::AllowedCollisionMatrixModel(const AllowedCollisionMatrixModel &other)
-  : QStandardItemModel(other.d_ptr->parent)
+  : QAbstractTableModel(other.d_ptr->parent)
 {
   this->env_ = other.env_;
+  this->entries_ = other.entries_;
 }
 
 AllowedCollisionMatrixModel &AllowedCollisionMatrixModel::operator=(const AllowedCollisionMatrixModel &other)
 {
+  beginResetModel();
   this->env_ = other.env_;
+  this->entries_ = other.entries_;
+  endResetModel();
   return *this;
 }
 
@@ -54,61 +79,246 @@ QHash<int, QByteArray> AllowedCollisionMatrixModel::roleNames() const
     return roles;
 }
 
+int AllowedCollisionMatrixModel::rowCount(const QModelIndex &parent) const
+{
+  if (parent.isValid())
+    return 0;
+
+  return static_cast<int>(entries_.size());
+}
+
+int AllowedCollisionMatrixModel::columnCount(const QModelIndex &parent) const
+{
+  if (parent.isValid())
+    return 0;
+
+  return 3;
+}
+
+QVariant AllowedCollisionMatrixModel::data(const QModelIndex &index, int role) const
+{
+  if (!index.isValid() || index.row() < 0 || index.row() >= rowCount())
+    return QVariant();
+
+  const Entry& entry = entries_[static_cast<std::size_t>(index.row())];
+  switch (role)
+  {
+    case Link1Role:
+      return entry.link1;
+    case Link2Role:
+      return entry.link2;
+    case ReasonRole:
+      return entry.reason;
+    case Qt::DisplayRole:
+    {
+      // Widget views use one column per field while QML views use the roles
+      if (index.column() == 0)
+        return entry.link1;
+      if (index.column() == 1)
+        return entry.link2;
+      return entry.reason;
+    }
+    default:
+      return QVariant();
+  }
+}
+
+QVariant AllowedCollisionMatrixModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+  if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+    return QAbstractTableModel::headerData(section, orientation, role);
+
+  switch (section)
+  {
+    case 0:
+      return QString("Link 1");
+    case 1:
+      return QString("Link 2");
+    case 2:
+      return QString("Reason");
+    default:
+      return QVariant();
+  }
+}
+
 void AllowedCollisionMatrixModel::setEnvironment(tesseract_environment::Environment::Ptr env)
 {
-  QStandardItemModel::clear();
+  beginResetModel();
   env_ = env;
-  QStandardItem *parent_item = this->invisibleRootItem();
-  for (const auto& ac : env_->getSceneGraph()->getAllowedCollisionMatrix()->getAllAllowedCollisions())
+  entries_.clear();
+  const auto& acm = env_->getSceneGraph()->getAllowedCollisionMatrix()->getAllAllowedCollisions();
+  entries_.reserve(acm.size());
+  for (const auto& ac : acm)
+  {
+    entries_.push_back({ QString::fromStdString(ac.first.first),
+                         QString::fromStdString(ac.first.second),
+                         QString::fromStdString(ac.second) });
+  }
+
+  // Sort once and drop duplicates in case the matrix stores both orders of a pair
+  normalize(entries_);
+  endResetModel();
+}
+
+void AllowedCollisionMatrixModel::normalize(std::vector<Entry>& entries)
+{
+  for (auto& entry : entries)
+  {
+    if (entry.link2 < entry.link1)
+      std::swap(entry.link1, entry.link2);
+  }
+
+  std::stable_sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+    return entryLess(a, std::make_pair(b.link1, b.link2));
+  });
+
+  // Keep the last of each run of equal pairs, matching the result of adding the entries one by one
+  auto same_pair = [](const Entry& a, const Entry& b) { return a.link1 == b.link1 && a.link2 == b.link2; };
+  std::vector<Entry> unique_entries;
+  unique_entries.reserve(entries.size());
+  for (std::size_t i = 0; i < entries.size(); ++i)
+  {
+    if (i + 1 < entries.size() && same_pair(entries[i], entries[i + 1]))
+      continue;
+
+    unique_entries.push_back(std::move(entries[i]));
+  }
+  entries = std::move(unique_entries);
+}
+
+void AllowedCollisionMatrixModel::apply(std::vector<Entry> entries)
+{
+  normalize(entries);
+
+  // Both lists are sorted so the difference is found in a single merge pass
+  tesseract_environment::Commands commands;
+  auto current = entries_.cbegin();
+  auto target = entries.cbegin();
+  while (current != entries_.cend() || target != entries.cend())
   {
-    auto item = new QStandardItem();
-    item->setData(QString::fromStdString(ac.first.first), AllowedCollisionMatrixRoles::Link1Role);
-    item->setData(QString::fromStdString(ac.first.second), AllowedCollisionMatrixRoles::Link2Role);
-    item->setData(QString::fromStdString(ac.second), AllowedCollisionMatrixRoles::ReasonRole);
-    parent_item->appendRow(item);
+    if (target == entries.cend() ||
+        (current != entries_.cend() && entryLess(*current, std::make_pair(target->link1, target->link2))))
+    {
+      commands.push_back(std::make_shared<tesseract_environment::RemoveAllowedCollisionCommand>(
+          current->link1.toStdString(), current->link2.toStdString()));
+      ++current;
+    }
+    else if (current == entries_.cend() || entryLess(*target, std::make_pair(current->link1, current->link2)))
+    {
+      commands.push_back(std::make_shared<tesseract_environment::AddAllowedCollisionCommand>(
+          target->link1.toStdString(), target->link2.toStdString(), target->reason.toStdString()));
+      ++target;
+    }
+    else
+    {
+      if (current->reason != target->reason)
+      {
+        commands.push_back(std::make_shared<tesseract_environment::AddAllowedCollisionCommand>(
+            target->link1.toStdString(), target->link2.toStdString(), target->reason.toStdString()));
+      }
+      ++current;
+      ++target;
+    }
   }
-  sort(0);
+
+  if (env_ && !commands.empty() && !env_->applyCommands(commands))
+  {
+    // Fall back to the environment's matrix so the model does not show entries that were not applied
+    setEnvironment(env_);
+    return;
+  }
+
+  beginResetModel();
+  entries_ = std::move(entries);
+  endResetModel();
+}
+
+std::vector<AllowedCollisionMatrixModel::Entry>::const_iterator
+AllowedCollisionMatrixModel::lowerBound(const QString& link_name1, const QString& link_name2) const
+{
+  return std::lower_bound(entries_.begin(), entries_.end(), std::make_pair(link_name1, link_name2), entryLess);
+}
+
+int AllowedCollisionMatrixModel::find(const QString& link_name1, const QString& link_name2) const
+{
+  auto pair = makeOrderedPair(link_name1, link_name2);
+  auto it = lowerBound(pair.first, pair.second);
+  if (it == entries_.end() || it->link1 != pair.first || it->link2 != pair.second)
+    return -1;
+
+  return static_cast<int>(std::distance(entries_.begin(), it));
+}
+
+tesseract_environment::Environment::ConstPtr AllowedCollisionMatrixModel::getEnvironment() const
+{
+  return env_;
+}
+
+const std::vector<AllowedCollisionMatrixModel::Entry>& AllowedCollisionMatrixModel::getEntries() const
+{
+  return entries_;
 }
 
 void AllowedCollisionMatrixModel::add(const QString& link_name1, const QString& link_name2, const QString& reason)
 {
   env_->addAllowedCollision(link_name1.toStdString(), link_name2.toStdString(), reason.toStdString());
-  QStandardItem *parent_item = this->invisibleRootItem();
-  auto item = new QStandardItem();
-  item->setData(link_name1, AllowedCollisionMatrixRoles::Link1Role);
-  item->setData(link_name2, AllowedCollisionMatrixRoles::Link2Role);
-  item->setData(reason, AllowedCollisionMatrixRoles::ReasonRole);
-  parent_item->appendRow(item);
-  sort(0);
-
-  // If the count does not match then it was a replace so rebuild model.
-  if (parent_item->rowCount() != static_cast<int>(env_->getSceneGraph()->getAllowedCollisionMatrix()->getAllAllowedCollisions().size()))
-    setEnvironment(env_);
+
+  auto pair = makeOrderedPair(link_name1, link_name2);
+  auto it = lowerBound(pair.first, pair.second);
+  int row = static_cast<int>(std::distance(entries_.cbegin(), it));
+
+  // If the pair already exists then it was a replace so only the reason changes
+  if (it != entries_.end() && it->link1 == pair.first && it->link2 == pair.second)
+  {
+    entries_[static_cast<std::size_t>(row)].reason = reason;
+    emit dataChanged(index(row, 0), index(row, columnCount() - 1));
+    return;
+  }
+
+  beginInsertRows(QModelIndex(), row, row);
+  entries_.insert(entries_.begin() + row, { pair.first, pair.second, reason });
+  endInsertRows();
 }
 
 bool AllowedCollisionMatrixModel::removeRows(int row, int count, const QModelIndex &parent)
 {
-  if (row >= 0)
-  {
-    QStandardItem *row_item = item(row);
-    QString link1_name = row_item->data(AllowedCollisionMatrixRoles::Link1Role).toString();
-    QString link2_name = row_item->data(AllowedCollisionMatrixRoles::Link2Role).toString();
-    env_->removeAllowedCollision(link1_name.toStdString(), link2_name.toStdString());
+  if (parent.isValid() || row < 0 || count <= 0 || (row + count) > rowCount())
+    return false;
 
-    return QStandardItemModel::removeRows(row, count, parent);
-  }
-  return false;
+  auto first = entries_.begin() + row;
+  auto last = first + count;
+  for (auto it = first; it != last; ++it)
+    env_->removeAllowedCollision(it->link1.toStdString(), it->link2.toStdString());
+
+  beginRemoveRows(parent, row, row + count - 1);
+  entries_.erase(first, last);
+  endRemoveRows();
+  return true;
 }
 
 void AllowedCollisionMatrixModel::clear()
 {
-  QStandardItemModel::clear();
+  beginResetModel();
+  entries_.clear();
   if (env_)
   {
-    tesseract_scene_graph::AllowedCollisionMatrix acm(*(env_->getSceneGraph()->getAllowedCollisionMatrix()));
-    for (const auto& entry : acm.getAllAllowedCollisions())
-      env_->removeAllowedCollision(entry.first.first, entry.first.second);
+    // Removing the entries by link needs one command per link instead of one per entry
+    std::set<std::string> link_names;
+    for (const auto& entry : env_->getSceneGraph()->getAllowedCollisionMatrix()->getAllAllowedCollisions())
+    {
+      link_names.insert(entry.first.first);
+      link_names.insert(entry.first.second);
+    }
+
+    tesseract_environment::Commands commands;
+    commands.reserve(link_names.size());
+    for (const auto& link_name : link_names)
+      commands.push_back(std::make_shared<tesseract_environment::RemoveAllowedCollisionLinkCommand>(link_name));
+
+    if (!commands.empty())
+      env_->applyCommands(commands);
   }
+  endResetModel();
 }
 
 }
@@ -72,6 +72,25 @@ void JointListModel::add(tesseract_scene_graph::Joint::ConstPtr joint)
   }
 }
 
+bool JointListModel::setValue(int row, double value)
+{
+  QStandardItem* row_item = item(row);
+  if (row_item == nullptr)
+    return false;
+
+  row_item->setData(QString::number(value), JointRoles::ValueRole);
+  return true;
+}
+
+QString JointListModel::getName(int row) const
+{
+  QStandardItem* row_item = item(row);
+  if (row_item == nullptr)
+    return QString();
+
+  return row_item->data(JointRoles::NameRole).toString();
+}
+
 void JointListModel::clear()
 {
   QStandardItemModel::clear();
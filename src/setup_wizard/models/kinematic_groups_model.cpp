@@ -1,6 +1,6 @@
 /**
  * @file kinematic_groups_model.cpp
- * @brief A Qt Standard Item Model for Tesseract Kinematic Groups
+ * @brief A Qt List Model for Tesseract Kinematic Groups
  *
  * @author Levi Armstrong
  * @date May 14, 2020
@@ -25,175 +25,248 @@
  */
 
 #include <tesseract_ignition/setup_wizard/models/kinematic_groups_model.h>
+#include <QMetaObject>
+#include <algorithm>
+#include <chrono>
 
 namespace tesseract_ignition
 {
 
 KinematicGroupsModel::KinematicGroupsModel(QObject *parent)
-  : QStandardItemModel(parent)
+  : QAbstractListModel(parent)
 {
 }
 
 KinematicGroupsModel::KinematicGroupsModel(const KinematicGroupsModel &other)
-  : QStandardItemModel(other.d_ptr->parent)
+  : QAbstractListModel(other.d_ptr->parent)
 {
   this->env_ = other.env_;
+  this->groups_ = other.groups_;
 }
 
 KinematicGroupsModel &KinematicGroupsModel::operator=(const KinematicGroupsModel &other)
 {
+  beginResetModel();
   this->env_ = other.env_;
+  this->groups_ = other.groups_;
+  endResetModel();
   return *this;
 }
 
+KinematicGroupsModel::~KinematicGroupsModel()
+{
+  // The tasks post their results to this object so they must finish before it is destroyed
+  for (auto& task : tasks_)
+    task.wait();
+}
+
 QHash<int, QByteArray> KinematicGroupsModel::roleNames() const
 {
     QHash<int, QByteArray> roles;
     roles[NameRole] = "name";
     roles[TypeRole] = "type";
     roles[DataRole] = "data";
+    roles[StatusRole] = "status";
+    roles[JointsRole] = "joints";
+    roles[LinksRole] = "links";
+    roles[BaseLinkRole] = "base";
+    roles[TipLinkRole] = "tip";
     return roles;
 }
 
+int KinematicGroupsModel::rowCount(const QModelIndex &parent) const
+{
+  if (parent.isValid())
+    return 0;
+
+  return static_cast<int>(groups_.size());
+}
+
+QVariant KinematicGroupsModel::data(const QModelIndex &index, int role) const
+{
+  if (!index.isValid() || index.row() < 0 || index.row() >= rowCount())
+    return QVariant();
+
+  const Group& group = groups_[static_cast<std::size_t>(index.row())];
+  bool is_chain = (group.type == "Chain");
+  switch (role)
+  {
+    case Qt::DisplayRole:
+    case NameRole:
+      return group.name;
+    case TypeRole:
+      return group.type;
+    case DataRole:
+      return group.data.join(",");
+    case StatusRole:
+      return group.status;
+    case JointsRole:
+      return group.joints;
+    case LinksRole:
+      return (group.type == "Link List") ? group.data : QStringList();
+    case BaseLinkRole:
+      return (is_chain && group.data.size() == 2) ? group.data[0] : QString();
+    case TipLinkRole:
+      return (is_chain && group.data.size() == 2) ? group.data[1] : QString();
+    default:
+      return QVariant();
+  }
+}
+
+QString KinematicGroupsModel::getName(int row) const
+{
+  if (row < 0 || row >= rowCount())
+    return QString();
+
+  return groups_[static_cast<std::size_t>(row)].name;
+}
+
+void KinematicGroupsModel::clear()
+{
+  beginResetModel();
+  groups_.clear();
+  pending_.clear();
+  endResetModel();
+}
+
 void KinematicGroupsModel::setEnvironment(tesseract_environment::Environment::Ptr env)
 {
-  this->clear();
+  beginResetModel();
+  groups_.clear();
+
+  // Solvers and pending results belong to the previous environment
+  if (env_ != env)
+  {
+    solver_cache_.clear();
+    solver_cache_revision_ = -1;
+  }
+  pending_.clear();
 
   env_ = env;
-  QStandardItem *parent_item = this->invisibleRootItem();
-  for (const auto& group : env->getManipulatorManager()->getChainGroups())
+  auto toStringList = [](const std::vector<std::string>& names) {
+    QStringList list;
+    list.reserve(static_cast<int>(names.size()));
+    for (const auto& name : names)
+      list.push_back(QString::fromStdString(name));
+    return list;
+  };
+
+  auto manager = env->getManipulatorManager();
+  for (const auto& group : manager->getChainGroups())
   {
     if (!group.second.empty())
     {
-      auto item = new QStandardItem();
-      item->setData(QString::fromStdString(group.first), KinematicGroupsRoles::NameRole);
-      item->setData(QString::fromStdString("Chain"), KinematicGroupsRoles::TypeRole);
-      QString data = QString::fromStdString(group.second[0].first) + "," + QString::fromStdString(group.second[0].second);
-      item->setData(data, this->roleNames().key("data"));
-      parent_item->appendRow(item);
+      QStringList data = { QString::fromStdString(group.second[0].first), QString::fromStdString(group.second[0].second) };
+      Solvers solvers { manager->getFwdKinematicSolver(group.first), manager->getInvKinematicSolver(group.first) };
+      groups_.push_back({ QString::fromStdString(group.first), "Chain", data, "Ready", getJoints("Chain", data, solvers) });
     }
   }
 
-  for (const auto& group : env->getManipulatorManager()->getJointGroups())
+  for (const auto& group : manager->getJointGroups())
   {
     if (!group.second.empty())
     {
-      auto item = new QStandardItem();
-      item->setData(QString::fromStdString(group.first), KinematicGroupsRoles::NameRole);
-      item->setData(QString::fromStdString("Joint List"), KinematicGroupsRoles::TypeRole);
-      QString data = QString::fromStdString(group.second[0]);
-      for (std::size_t i = 1; i < group.second.size(); ++i)
-        data += ("," + QString::fromStdString(group.second[i]));
-      item->setData(data, this->roleNames().key("data"));
-      parent_item->appendRow(item);
+      QStringList data = toStringList(group.second);
+      groups_.push_back({ QString::fromStdString(group.first), "Joint List", data, "Ready", data });
     }
   }
 
-  for (const auto& group : env->getManipulatorManager()->getLinkGroups())
+  for (const auto& group : manager->getLinkGroups())
   {
     if (!group.second.empty())
-    {
-      auto item = new QStandardItem();
-      item->setData(QString::fromStdString(group.first), KinematicGroupsRoles::NameRole);
-      item->setData(QString::fromStdString("Link List"), KinematicGroupsRoles::TypeRole);
-      QString data = QString::fromStdString(group.second[0]);
-      for (std::size_t i = 1; i < group.second.size(); ++i)
-        data += ("," + QString::fromStdString(group.second[i]));
-      item->setData(data, this->roleNames().key("data"));
-      parent_item->appendRow(item);
-    }
+      groups_.push_back({ QString::fromStdString(group.first), "Link List", toStringList(group.second), "Ready", QStringList() });
   }
+  endResetModel();
 }
 
 void KinematicGroupsModel::add(const QString& group_name, const QString& type, const QStringList& data)
 {
-  QStandardItem *parent_item = this->invisibleRootItem();
   QString group_name_trimmed = group_name.trimmed();
 
-  if (type == "Chain")
+  if (type == "Chain" || type == "Joint List")
   {
-    std::vector<std::string> fwd_solver_names = this->env_->getManipulatorManager()->getAvailableFwdKinematicsSolvers(tesseract_kinematics::ForwardKinematicsFactoryType::CHAIN);
-    std::vector<std::string> inv_solver_names = this->env_->getManipulatorManager()->getAvailableInvKinematicsSolvers(tesseract_kinematics::InverseKinematicsFactoryType::CHAIN);
-    if (!fwd_solver_names.empty() || !inv_solver_names.empty())
+    bool is_chain = (type == "Chain");
+    if (data.empty() || (is_chain && data.size() != 2))
     {
-      this->env_->getManipulatorManager()->removeFwdKinematicSolver(group_name_trimmed.toStdString());
-      this->env_->getManipulatorManager()->removeInvKinematicSolver(group_name_trimmed.toStdString());
+      CONSOLE_BRIDGE_logError("Tried to add kinematic group with invalid data!");
+      return;
+    }
 
-      bool fwd_good { false };
-      bool inv_good { false };
+    auto manager = this->env_->getManipulatorManager();
+    std::vector<std::string> fwd_solver_names = manager->getAvailableFwdKinematicsSolvers(is_chain ? tesseract_kinematics::ForwardKinematicsFactoryType::CHAIN : tesseract_kinematics::ForwardKinematicsFactoryType::TREE);
+    std::vector<std::string> inv_solver_names = manager->getAvailableInvKinematicsSolvers(is_chain ? tesseract_kinematics::InverseKinematicsFactoryType::CHAIN : tesseract_kinematics::InverseKinematicsFactoryType::TREE);
+    if (fwd_solver_names.empty() && inv_solver_names.empty())
+      return;
 
-      if (!fwd_solver_names.empty())
-      {
-        auto fwd_factory = this->env_->getManipulatorManager()->getFwdKinematicFactory(fwd_solver_names[0]);
-        auto fwd_kin = fwd_factory->create(this->env_->getSceneGraph(), data[0].toStdString(), data[1].toStdString(), group_name_trimmed.toStdString());
-        fwd_good = fwd_kin != nullptr && this->env_->getManipulatorManager()->addFwdKinematicSolver(fwd_kin);
-      }
-      if (!inv_solver_names.empty())
-      {
-        auto inv_factory = this->env_->getManipulatorManager()->getInvKinematicFactory(inv_solver_names[0]);
-        auto inv_kin = inv_factory->create(this->env_->getSceneGraph(), data[0].toStdString(), data[1].toStdString(), group_name_trimmed.toStdString());
-        inv_good = inv_kin != nullptr && this->env_->getManipulatorManager()->addInvKinematicSolver(inv_kin);
-      }
-
-      if (fwd_good || inv_good)
-      {
-        this->env_->getManipulatorManager()->addChainGroup(group_name_trimmed.toStdString(), {std::make_pair(data[0].toStdString(), data[1].toStdString())});
-
-        auto item = new QStandardItem();
-        item->setData(group_name_trimmed, KinematicGroupsRoles::NameRole);
-        item->setData("Chain", KinematicGroupsRoles::TypeRole);
-        QString d = data[0] + "," + data[1];
-        item->setData(d, KinematicGroupsRoles::DataRole);
-        parent_item->appendRow(item);
-      }
+    std::string fwd_solver_name = (fwd_solver_names.empty()) ? "" : fwd_solver_names[0];
+    std::string inv_solver_name = (inv_solver_names.empty()) ? "" : inv_solver_names[0];
+    // The solvers are built on the scene graph, so they are only reused while the environment is not changed.
+    // Solvers still being created for an older revision keep its number in their key and are never found.
+    int revision = this->env_->getRevision();
+    if (revision != solver_cache_revision_)
+    {
+      solver_cache_.clear();
+      solver_cache_revision_ = revision;
     }
-  }
-  else if (type == "Joint List")
-  {
-    std::vector<std::string> fwd_solver_names = this->env_->getManipulatorManager()->getAvailableFwdKinematicsSolvers(tesseract_kinematics::ForwardKinematicsFactoryType::TREE);
-    std::vector<std::string> inv_solver_names = this->env_->getManipulatorManager()->getAvailableInvKinematicsSolvers(tesseract_kinematics::InverseKinematicsFactoryType::TREE);
-    if (!fwd_solver_names.empty() || !inv_solver_names.empty())
+
+    std::string key = group_name_trimmed.toStdString() + "|" + type.toStdString() + "|" + data.join(",").toStdString() +
+                      "|" + fwd_solver_name + "|" + inv_solver_name + "|" + std::to_string(revision);
+
+    // A newer request for the group replaces any request still pending
+    pending_.erase(group_name_trimmed);
+
+    auto cached = solver_cache_.find(key);
+    if (cached != solver_cache_.end())
     {
-      this->env_->getManipulatorManager()->removeFwdKinematicSolver(group_name_trimmed.toStdString());
-      this->env_->getManipulatorManager()->removeInvKinematicSolver(group_name_trimmed.toStdString());
+      bool good = addGroup(group_name_trimmed, type, data, cached->second);
+      setRow(group_name_trimmed, type, data, (good) ? "Ready" : "Failed", getJoints(type, data, cached->second));
+      return;
+    }
 
-      bool fwd_good { false };
-      bool inv_good { false };
+    // Drop the tasks that are done, their futures would otherwise pile up
+    tasks_.erase(std::remove_if(tasks_.begin(), tasks_.end(), [](const std::future<void>& task) {
+      return task.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }), tasks_.end());
 
-      std::vector<std::string> joints;
-      for (const auto& j : data)
-        joints.push_back(j.toStdString());
+    std::uint64_t task_id = ++last_task_id_;
+    pending_[group_name_trimmed] = task_id;
+    setRow(group_name_trimmed, type, data, "Pending", getJoints(type, data, Solvers()));
 
-      if (!fwd_solver_names.empty())
+    // The solvers are built from a copy of the scene graph so the environment can keep changing meanwhile
+    auto fwd_factory = (fwd_solver_name.empty()) ? nullptr : manager->getFwdKinematicFactory(fwd_solver_name);
+    auto inv_factory = (inv_solver_name.empty()) ? nullptr : manager->getInvKinematicFactory(inv_solver_name);
+    tesseract_scene_graph::SceneGraph::ConstPtr scene_graph = this->env_->getSceneGraph()->clone();
+    std::vector<std::string> names;
+    for (const auto& d : data)
+      names.push_back(d.toStdString());
+
+    tasks_.push_back(std::async(std::launch::async, [this, is_chain, fwd_factory, inv_factory, scene_graph, names, key, task_id, group_name_trimmed, type, data]() {
+      Solvers solvers;
+      std::string name = group_name_trimmed.toStdString();
+      if (is_chain)
       {
-        auto fwd_factory = this->env_->getManipulatorManager()->getFwdKinematicFactory(fwd_solver_names[0]);
-        auto fwd_kin = fwd_factory->create(this->env_->getSceneGraph(), joints, group_name_trimmed.toStdString());
-        fwd_good = fwd_kin != nullptr && this->env_->getManipulatorManager()->addFwdKinematicSolver(fwd_kin);
+        if (fwd_factory)
+          solvers.fwd_kin = fwd_factory->create(scene_graph, names[0], names[1], name);
+        if (inv_factory)
+          solvers.inv_kin = inv_factory->create(scene_graph, names[0], names[1], name);
       }
-      if (!inv_solver_names.empty())
+      else
       {
-        auto inv_factory = this->env_->getManipulatorManager()->getInvKinematicFactory(inv_solver_names[0]);
-        auto inv_kin = inv_factory->create(this->env_->getSceneGraph(), joints, group_name_trimmed.toStdString());
-        inv_good = inv_kin != nullptr && this->env_->getManipulatorManager()->addInvKinematicSolver(inv_kin);
+        if (fwd_factory)
+          solvers.fwd_kin = fwd_factory->create(scene_graph, names, name);
+        if (inv_factory)
+          solvers.inv_kin = inv_factory->create(scene_graph, names, name);
       }
 
-      if (fwd_good || inv_good)
-      {
-        this->env_->getManipulatorManager()->addJointGroup(group_name_trimmed.toStdString(), joints);
-
-        auto item = new QStandardItem();
-        item->setData(group_name_trimmed, KinematicGroupsRoles::NameRole);
-        item->setData("Joint List", KinematicGroupsRoles::TypeRole);
-        QString d = data[0];
-        for (int i = 1; i < data.size(); ++i)
-          d += ("," + data[i]);
-        item->setData(d, KinematicGroupsRoles::DataRole);
-        parent_item->appendRow(item);
-      }
-    }
+      QMetaObject::invokeMethod(this, [this, group_name_trimmed, type, data, key, task_id, solvers]() {
+        onSolversCreated(group_name_trimmed, type, data, key, task_id, solvers);
+      }, Qt::QueuedConnection);
+    }));
   }
   else if (type == "Link List")
   {
+    // No solver is created for link lists yet, see the TODO below, so there is nothing to build in the background
+    // or to cache
     std::vector<std::string> fwd_solver_names = this->env_->getManipulatorManager()->getAvailableFwdKinematicsSolvers(tesseract_kinematics::ForwardKinematicsFactoryType::TREE);
     std::vector<std::string> inv_solver_names = this->env_->getManipulatorManager()->getAvailableInvKinematicsSolvers(tesseract_kinematics::InverseKinematicsFactoryType::TREE);
 
@@ -226,15 +299,7 @@ void KinematicGroupsModel::add(const QString& group_name, const QString& type, c
       if (fwd_good || inv_good)
       {
         this->env_->getManipulatorManager()->addLinkGroup(group_name_trimmed.toStdString(), links);
-
-        auto item = new QStandardItem();
-        item->setData(group_name_trimmed, KinematicGroupsRoles::NameRole);
-        item->setData("Link List", KinematicGroupsRoles::TypeRole);
-        QString d = data[0];
-        for (int i = 1; i < data.size(); ++i)
-          d += ("," + data[i]);
-        item->setData(d, KinematicGroupsRoles::DataRole);
-        parent_item->appendRow(item);
+        setRow(group_name_trimmed, "Link List", data, "Ready");
       }
     }
   }
@@ -242,41 +307,132 @@ void KinematicGroupsModel::add(const QString& group_name, const QString& type, c
   {
     CONSOLE_BRIDGE_logError("Tried to add unknown kinematic group type!");
   }
+}
+
+bool KinematicGroupsModel::addGroup(const QString& group_name, const QString& type, const QStringList& data, const Solvers& solvers)
+{
+  auto manager = this->env_->getManipulatorManager();
+  std::string name = group_name.toStdString();
+  manager->removeFwdKinematicSolver(name);
+  manager->removeInvKinematicSolver(name);
+
+  bool fwd_good = solvers.fwd_kin != nullptr && manager->addFwdKinematicSolver(solvers.fwd_kin);
+  bool inv_good = solvers.inv_kin != nullptr && manager->addInvKinematicSolver(solvers.inv_kin);
+  if (!fwd_good && !inv_good)
+    return false;
 
-  // If the count does not match then it was a replace so rebuild model.
-  std::size_t num_groups = this->env_->getManipulatorManager()->getChainGroups().size() + this->env_->getManipulatorManager()->getJointGroups().size() + this->env_->getManipulatorManager()->getLinkGroups().size();
-  if (parent_item->rowCount() != static_cast<int>(num_groups))
-    setEnvironment(env_);
+  if (type == "Chain")
+  {
+    manager->addChainGroup(name, {std::make_pair(data[0].toStdString(), data[1].toStdString())});
+  }
+  else
+  {
+    std::vector<std::string> joints;
+    for (const auto& j : data)
+      joints.push_back(j.toStdString());
+    manager->addJointGroup(name, joints);
+  }
+  return true;
 }
 
-bool KinematicGroupsModel::removeRows(int row, int count, const QModelIndex &parent)
+void KinematicGroupsModel::onSolversCreated(const QString& group_name,
+                                            const QString& type,
+                                            const QStringList& data,
+                                            const std::string& key,
+                                            std::uint64_t task_id,
+                                            const Solvers& solvers)
+{
+  // A failed creation is not cached so adding the group again tries again
+  if (solvers.fwd_kin != nullptr || solvers.inv_kin != nullptr)
+    solver_cache_[key] = solvers;
+
+  // Ignore the result if the group was removed or added again since the task started
+  auto it = pending_.find(group_name);
+  if (it == pending_.end() || it->second != task_id)
+    return;
+
+  pending_.erase(it);
+  bool good = addGroup(group_name, type, data, solvers);
+  setRow(group_name, type, data, (good) ? "Ready" : "Failed", getJoints(type, data, solvers));
+}
+
+QStringList KinematicGroupsModel::getJoints(const QString& type, const QStringList& data, const Solvers& solvers)
 {
-  if (row >= 0)
+  if (type == "Joint List")
+    return data;
+
+  if (type != "Chain")
+    return QStringList();
+
+  QStringList joints;
+  const std::vector<std::string>* joint_names = nullptr;
+  if (solvers.fwd_kin != nullptr)
+    joint_names = &solvers.fwd_kin->getJointNames();
+  else if (solvers.inv_kin != nullptr)
+    joint_names = &solvers.inv_kin->getJointNames();
+
+  if (joint_names != nullptr)
   {
-    QStandardItem *row_item = item(row);
-    QString group_name = row_item->data(KinematicGroupsRoles::NameRole).toString();
-    QString type = row_item->data(KinematicGroupsRoles::TypeRole).toString();
-    if (type == "Chain")
-    {
-      env_->getManipulatorManager()->removeFwdKinematicSolver(group_name.toStdString());
-      env_->getManipulatorManager()->removeInvKinematicSolver(group_name.toStdString());
-      this->env_->getManipulatorManager()->removeChainGroup(group_name.toStdString());
-    }
-    else if (type == "Joint List")
-    {
-      env_->getManipulatorManager()->removeFwdKinematicSolver(group_name.toStdString());
-      env_->getManipulatorManager()->removeInvKinematicSolver(group_name.toStdString());
-      this->env_->getManipulatorManager()->removeJointGroup(group_name.toStdString());
-    }
-    else if (type == "Link List")
-    {
-      env_->getManipulatorManager()->removeFwdKinematicSolver(group_name.toStdString());
-      env_->getManipulatorManager()->removeInvKinematicSolver(group_name.toStdString());
-      this->env_->getManipulatorManager()->removeLinkGroup(group_name.toStdString());
-    }
+    for (const auto& joint_name : *joint_names)
+      joints.push_back(QString::fromStdString(joint_name));
+  }
+  return joints;
+}
 
-    return QStandardItemModel::removeRows(row, count, parent);
+int KinematicGroupsModel::findRow(const QString& group_name) const
+{
+  for (std::size_t row = 0; row < groups_.size(); ++row)
+  {
+    if (groups_[row].name == group_name)
+      return static_cast<int>(row);
   }
-  return false;
+  return -1;
+}
+
+void KinematicGroupsModel::setRow(const QString& group_name,
+                                  const QString& type,
+                                  const QStringList& data,
+                                  const QString& status,
+                                  const QStringList& joints)
+{
+  int row = findRow(group_name);
+  if (row < 0)
+  {
+    row = rowCount();
+    beginInsertRows(QModelIndex(), row, row);
+    groups_.push_back({ group_name, type, data, status, joints });
+    endInsertRows();
+    return;
+  }
+
+  groups_[static_cast<std::size_t>(row)] = { group_name, type, data, status, joints };
+  emit dataChanged(index(row), index(row));
+}
+
+bool KinematicGroupsModel::removeRows(int row, int count, const QModelIndex &parent)
+{
+  if (parent.isValid() || row < 0 || count <= 0 || (row + count) > rowCount())
+    return false;
+
+  auto manager = env_->getManipulatorManager();
+  for (int r = row; r < row + count; ++r)
+  {
+    const Group& group = groups_[static_cast<std::size_t>(r)];
+    std::string group_name = group.name.toStdString();
+    pending_.erase(group.name);
+    manager->removeFwdKinematicSolver(group_name);
+    manager->removeInvKinematicSolver(group_name);
+    if (group.type == "Chain")
+      manager->removeChainGroup(group_name);
+    else if (group.type == "Joint List")
+      manager->removeJointGroup(group_name);
+    else if (group.type == "Link List")
+      manager->removeLinkGroup(group_name);
+  }
+
+  beginRemoveRows(parent, row, row + count - 1);
+  groups_.erase(groups_.begin() + row, groups_.begin() + row + count);
+  endRemoveRows();
+  return true;
 }
 }
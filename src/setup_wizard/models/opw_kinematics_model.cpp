@@ -27,10 +27,48 @@
 #include <tesseract_ignition/setup_wizard/models/opw_kinematics_model.h>
 #include <Eigen/Geometry>
 #include <QVector3D>
+#include <QMetaObject>
+#include <algorithm>
+#include <chrono>
 
 namespace tesseract_ignition
 {
 
+/** @brief Summarize the round trip errors of a validation */
+static QString toValidationString(const OPWValidationResult& result)
+{
+  QString validation = QString("%1% of %2 poses, position p95/max %3/%4 m, orientation p95/max %5/%6 rad")
+      .arg(100.0 * result.getSuccessRate(), 0, 'f', 1)
+      .arg(result.samples)
+      .arg(result.position_p95, 0, 'g', 3)
+      .arg(result.position_max, 0, 'g', 3)
+      .arg(result.orientation_p95, 0, 'g', 3)
+      .arg(result.orientation_max, 0, 'g', 3);
+
+  if (result.no_solution > 0)
+    validation += QString(", no solution for %1 poses").arg(result.no_solution);
+
+  return validation;
+}
+
+/** @brief Set the parameter columns of a row */
+static void setParameterData(QStandardItem* item, const tesseract_scene_graph::OPWKinematicParameters& opw)
+{
+  QString param_string = QString("a1: %1, a2: %2, b: %3, c1: %4, c2: %5, c3: %6, c4: %7").arg(opw.a1).arg(opw.a2).arg(opw.b).arg(opw.c1).arg(opw.c2).arg(opw.c3).arg(opw.c4);
+  item->setData(param_string, OPWKinematicsModel::KinematicParametersRole);
+
+  QString offsets_string = QString::number(opw.offsets[0]);
+  QString sign_corrections_string = QString::number(opw.sign_corrections[0]);
+  for (std::size_t i = 1; i < 6; ++i)
+  {
+    offsets_string += "," + QString::number(opw.offsets[i]);
+    sign_corrections_string += "," + QString::number(opw.sign_corrections[i]);
+  }
+
+  item->setData(offsets_string, OPWKinematicsModel::JointOffsetRole);
+  item->setData(sign_corrections_string, OPWKinematicsModel::JointCorrectionRole);
+}
+
 OPWKinematicsModel::OPWKinematicsModel(QObject *parent)
   : QStandardItemModel(parent)
 {
@@ -48,6 +86,13 @@ OPWKinematicsModel &OPWKinematicsModel::operator=(const OPWKinematicsModel &othe
   return *this;
 }
 
+OPWKinematicsModel::~OPWKinematicsModel()
+{
+  // The tasks post their results to this object so they must finish before it is destroyed
+  for (auto& task : tasks_)
+    task.wait();
+}
+
 QHash<int, QByteArray> OPWKinematicsModel::roleNames() const
 {
     QHash<int, QByteArray> roles;
@@ -55,16 +100,22 @@ QHash<int, QByteArray> OPWKinematicsModel::roleNames() const
     roles[KinematicParametersRole] = "parameters";
     roles[JointOffsetRole] = "offsets";
     roles[JointCorrectionRole] = "sign_corrections";
+    roles[ValidationRole] = "validation";
     return roles;
 }
 
 void OPWKinematicsModel::setEnvironment(tesseract_environment::Environment::Ptr env)
 {
   this->clear();
+  pending_.clear();
   env_ = env;
 
   for (const auto& group : env_->getManipulatorManager()->getOPWKinematicsSolvers())
-    addItem(QString::fromStdString(group.first), group.second);
+  {
+    QString group_name = QString::fromStdString(group.first);
+    addItem(group_name, group.second);
+    validate(group_name, group.second);
+  }
 }
 
 void OPWKinematicsModel::add(const QString& group_name,
@@ -73,12 +124,6 @@ void OPWKinematicsModel::add(const QString& group_name,
                              double o1, double o2, double o3, double o4, double o5, double o6,
                              int sc1, int sc2, int sc3, int sc4, int sc5, int sc6)
 {
-  const auto& group_opw_kinematics = env_->getManipulatorManager()->getOPWKinematicsSolvers();
-  bool add = false;
-
-  if (group_opw_kinematics.find(group_name.toStdString()) == group_opw_kinematics.end())
-    add = true;
-
   tesseract_scene_graph::OPWKinematicParameters opw_params;
   opw_params.a1 = a1;
   opw_params.a2 = a2;
@@ -100,12 +145,31 @@ void OPWKinematicsModel::add(const QString& group_name,
   opw_params.sign_corrections[4] = static_cast<signed char>(sc5);
   opw_params.sign_corrections[5] = static_cast<signed char>(sc6);
 
-  env_->getManipulatorManager()->addOPWKinematicsSolver(group_name.toStdString(), opw_params);
+  setParameters(group_name, opw_params);
+  validate(group_name, opw_params);
+}
 
-  if (add)
-    addItem(group_name, opw_params);
-  else // replace
-    setEnvironment(env_);
+void OPWKinematicsModel::fit(const QString& group_name)
+{
+  auto fwd_kin = env_->getManipulatorManager()->getFwdKinematicSolver(group_name.toStdString());
+  if (fwd_kin == nullptr)
+  {
+    CONSOLE_BRIDGE_logError("Failed to fit OPW kinematics, group %s has no forward kinematics!", group_name.toStdString().c_str());
+    return;
+  }
+
+  // Everything read from the environment is gathered here so the fit does not race later edits
+  fwd_kin = fwd_kin->clone();
+  std::vector<OPWJointFrame> frames = getOPWJointFrames(*env_, *fwd_kin);
+  Eigen::MatrixX2d limits = getOPWJointLimits(*env_, *fwd_kin);
+
+  std::uint64_t task_id = startTask(group_name);
+  tasks_.push_back(std::async(std::launch::async, [this, fwd_kin, frames, limits, group_name, task_id]() {
+    OPWFitResult result = fitOPWParameters(*fwd_kin, limits, frames, OPWFitConfig());
+    QMetaObject::invokeMethod(this, [this, group_name, task_id, result]() {
+      onFitted(group_name, task_id, result);
+    }, Qt::QueuedConnection);
+  }));
 }
 
 bool OPWKinematicsModel::removeRows(int row, int count, const QModelIndex &parent)
@@ -114,6 +178,7 @@ bool OPWKinematicsModel::removeRows(int row, int count, const QModelIndex &paren
   {
     QStandardItem *row_item = item(row);
     QString group_name = row_item->data(OPWKinematicsRoles::GroupNameRole).toString();
+    pending_.erase(group_name);
     env_->getManipulatorManager()->removeOPWKinematicsSovler(group_name.toStdString());
     return QStandardItemModel::removeRows(row, count, parent);
   }
@@ -125,21 +190,108 @@ void OPWKinematicsModel::addItem(const QString& group_name, const tesseract_scen
   QStandardItem *parent_item = this->invisibleRootItem();
   auto item = new QStandardItem();
   item->setData(group_name, OPWKinematicsRoles::GroupNameRole);
+  setParameterData(item, opw);
+  parent_item->appendRow(item);
+}
 
-  QString param_string = QString("a1: %1, a2: %2, b: %3, c1: %4, c2: %5, c3: %6, c4: %7").arg(opw.a1).arg(opw.a2).arg(opw.b).arg(opw.c1).arg(opw.c2).arg(opw.c3).arg(opw.c4);
-  item->setData(param_string, OPWKinematicsRoles::KinematicParametersRole);
+void OPWKinematicsModel::setParameters(const QString& group_name, const tesseract_scene_graph::OPWKinematicParameters& opw)
+{
+  env_->getManipulatorManager()->addOPWKinematicsSolver(group_name.toStdString(), opw);
 
-  QString offsets_string = QString::number(opw.offsets[0]);
-  QString sign_corrections_string = QString::number(opw.sign_corrections[0]);
-  for (std::size_t i = 0; i < 6; ++i)
+  // Update an existing row in place so the other rows keep their validation results
+  QStandardItem* item = findItem(group_name);
+  if (item != nullptr)
+    setParameterData(item, opw);
+  else
+    addItem(group_name, opw);
+}
+
+std::uint64_t OPWKinematicsModel::startTask(const QString& group_name)
+{
+  // Drop the tasks that are done, their futures would otherwise pile up
+  tasks_.erase(std::remove_if(tasks_.begin(), tasks_.end(), [](const std::future<void>& task) {
+    return task.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+  }), tasks_.end());
+
+  std::uint64_t task_id = ++last_task_id_;
+  pending_[group_name] = task_id;
+  return task_id;
+}
+
+void OPWKinematicsModel::validate(const QString& group_name, const tesseract_scene_graph::OPWKinematicParameters& opw)
+{
+  auto fwd_kin = env_->getManipulatorManager()->getFwdKinematicSolver(group_name.toStdString());
+  if (fwd_kin == nullptr)
   {
-    offsets_string += "," + QString::number(opw.offsets[i]);
-    sign_corrections_string += "," + QString::number(opw.sign_corrections[i]);
+    setValidation(group_name, "No forward kinematics");
+    return;
   }
 
-  item->setData(offsets_string, OPWKinematicsRoles::JointOffsetRole);
-  item->setData(sign_corrections_string, OPWKinematicsRoles::JointCorrectionRole);
-  parent_item->appendRow(item);
+  fwd_kin = fwd_kin->clone();
+  Eigen::MatrixX2d limits = getOPWJointLimits(*env_, *fwd_kin);
+
+  std::uint64_t task_id = startTask(group_name);
+  setValidation(group_name, "Validating");
+  tasks_.push_back(std::async(std::launch::async, [this, fwd_kin, limits, opw, group_name, task_id]() {
+    OPWValidationResult result = validateOPWParameters(*fwd_kin, limits, opw, OPWFitConfig());
+    QMetaObject::invokeMethod(this, [this, group_name, task_id, result]() {
+      onValidated(group_name, task_id, result);
+    }, Qt::QueuedConnection);
+  }));
+}
+
+void OPWKinematicsModel::onFitted(const QString& group_name, std::uint64_t task_id, const OPWFitResult& result)
+{
+  // Ignore the result if the group was removed or changed since the fit started
+  auto it = pending_.find(group_name);
+  if (it == pending_.end() || it->second != task_id)
+    return;
+
+  pending_.erase(it);
+
+  // Parameters which do not pass the round trip validation are never applied
+  if (!result.success || result.validation.getSuccessRate() < OPWFitConfig().min_success_rate)
+  {
+    CONSOLE_BRIDGE_logError("Failed to fit OPW kinematics for group %s: %s (position rms %g m, orientation rms %g rad, "
+                            "validation success rate %g)",
+                            group_name.toStdString().c_str(),
+                            result.message.c_str(),
+                            result.position_rms,
+                            result.orientation_rms,
+                            result.validation.getSuccessRate());
+    return;
+  }
+
+  setParameters(group_name, result.parameters);
+  setValidation(group_name, toValidationString(result.validation));
+}
+
+void OPWKinematicsModel::onValidated(const QString& group_name, std::uint64_t task_id, const OPWValidationResult& result)
+{
+  auto it = pending_.find(group_name);
+  if (it == pending_.end() || it->second != task_id)
+    return;
+
+  pending_.erase(it);
+  setValidation(group_name, toValidationString(result));
+}
+
+void OPWKinematicsModel::setValidation(const QString& group_name, const QString& validation)
+{
+  QStandardItem* item = findItem(group_name);
+  if (item != nullptr)
+    item->setData(validation, OPWKinematicsRoles::ValidationRole);
+}
+
+QStandardItem* OPWKinematicsModel::findItem(const QString& group_name) const
+{
+  for (int row = 0; row < rowCount(); ++row)
+  {
+    QStandardItem* row_item = item(row);
+    if (row_item->data(OPWKinematicsRoles::GroupNameRole).toString() == group_name)
+      return row_item;
+  }
+  return nullptr;
 }
 
 }
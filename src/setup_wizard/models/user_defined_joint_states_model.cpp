@@ -1,6 +1,6 @@
 /**
  * @file user_defined_joint_states_model.cpp
- * @brief A Qt Standard Item Model for User Defined Group Joint States
+ * @brief A Qt List Model for User Defined Group Joint States
  *
  * @author Levi Armstrong
  * @date May 14, 2020
@@ -25,27 +25,45 @@
  */
 
 #include <tesseract_ignition/setup_wizard/models/user_defined_joint_states_model.h>
+#include <QMetaObject>
+#include <QFile>
+#include <QTextStream>
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <limits>
 
 namespace tesseract_ignition
 {
 
 UserDefinedJointStatesModel::UserDefinedJointStatesModel(QObject *parent)
-  : QStandardItemModel(parent)
+  : QAbstractListModel(parent)
 {
 }
 
 UserDefinedJointStatesModel::UserDefinedJointStatesModel(const UserDefinedJointStatesModel &other)
-  : QStandardItemModel(other.d_ptr->parent)
+  : QAbstractListModel(other.d_ptr->parent)
 {
   this->env_ = other.env_;
+  this->rows_ = other.rows_;
 }
 
 UserDefinedJointStatesModel &UserDefinedJointStatesModel::operator=(const UserDefinedJointStatesModel &other)
 {
+  beginResetModel();
   this->env_ = other.env_;
+  this->rows_ = other.rows_;
+  endResetModel();
   return *this;
 }
 
+UserDefinedJointStatesModel::~UserDefinedJointStatesModel()
+{
+  // The checks post their results to this object so they must finish before it is destroyed
+  for (auto& task : tasks_)
+    task.wait();
+}
+
 QHash<int, QByteArray> UserDefinedJointStatesModel::roleNames() const
 {
     QHash<int, QByteArray> roles;
@@ -53,36 +71,98 @@ QHash<int, QByteArray> UserDefinedJointStatesModel::roleNames() const
     roles[StateNameRole] = "state_name";
     roles[JointNamesRole] = "joint_names";
     roles[JointValuesRole] = "joint_values";
+    roles[CollisionStatusRole] = "collision_status";
+    roles[MinDistanceRole] = "min_distance";
+    roles[CollisionPairsRole] = "collision_pairs";
     return roles;
 }
 
-void UserDefinedJointStatesModel::setEnvironment(tesseract_environment::Environment::Ptr env)
+int UserDefinedJointStatesModel::rowCount(const QModelIndex &parent) const
 {
-  this->clear();
-  env_ = env;
-  QStandardItem *parent_item = this->invisibleRootItem();
-  for (const auto& group : env_->getManipulatorManager()->getGroupJointStates())
+  if (parent.isValid())
+    return 0;
+
+  return static_cast<int>(rows_.size());
+}
+
+QVariant UserDefinedJointStatesModel::data(const QModelIndex &index, int role) const
+{
+  if (!index.isValid() || index.row() < 0 || index.row() >= rowCount())
+    return QVariant();
+
+  const Row& row = rows_[static_cast<std::size_t>(index.row())];
+  switch (role)
   {
-    for (const auto& state : group.second)
+    case Qt::DisplayRole:
+    case GroupNameRole:
+      return row.group_name;
+    case StateNameRole:
+      return row.state_name;
+    case JointNamesRole:
+    case JointValuesRole:
     {
+      const auto& group_states = env_->getManipulatorManager()->getGroupJointStates();
+      auto group = group_states.find(row.group_name.toStdString());
+      if (group == group_states.end())
+        return QVariant();
 
-      auto item = new QStandardItem();
-      item->setData(QString::fromStdString(group.first), UserDefinedJointStatesRoles::GroupNameRole);
-      item->setData(QString::fromStdString(state.first), UserDefinedJointStatesRoles::StateNameRole);
+      auto state = group->second.find(row.state_name.toStdString());
+      if (state == group->second.end())
+        return QVariant();
 
-      QStringList joint_names;
-      QStringList joint_values;
-      for (const auto& v : state.second)
-      {
-        joint_names.push_back(QString::fromStdString(v.first));
-        joint_values.push_back(QString::number(v.second));
-      }
-
-      item->setData(joint_names.join(","), UserDefinedJointStatesRoles::JointNamesRole);
-      item->setData(joint_values.join(","), UserDefinedJointStatesRoles::JointValuesRole);
-      parent_item->appendRow(item);
+      QStringList list;
+      list.reserve(static_cast<int>(state->second.size()));
+      for (const auto& v : state->second)
+        list.push_back((role == JointNamesRole) ? QString::fromStdString(v.first) : QString::number(v.second));
+
+      return list.join(",");
     }
+    case CollisionStatusRole:
+      return row.collision.status;
+    case MinDistanceRole:
+      return row.collision.min_distance;
+    case CollisionPairsRole:
+      return row.collision.pairs;
+    default:
+      return QVariant();
+  }
+}
+
+void UserDefinedJointStatesModel::resetRows()
+{
+  beginResetModel();
+  rows_.clear();
+  for (const auto& group : env_->getManipulatorManager()->getGroupJointStates())
+  {
+    for (const auto& state : group.second)
+      rows_.push_back({ QString::fromStdString(group.first), QString::fromStdString(state.first), {} });
+  }
+  endResetModel();
+}
+
+void UserDefinedJointStatesModel::setEnvironment(tesseract_environment::Environment::Ptr env)
+{
+  pending_.clear();
+  env_ = env;
+  resetRows();
+}
+
+void UserDefinedJointStatesModel::clear()
+{
+  beginResetModel();
+  rows_.clear();
+  pending_.clear();
+  endResetModel();
+}
+
+int UserDefinedJointStatesModel::findRow(const QString& group_name, const QString& state_name) const
+{
+  for (std::size_t row = 0; row < rows_.size(); ++row)
+  {
+    if (rows_[row].group_name == group_name && rows_[row].state_name == state_name)
+      return static_cast<int>(row);
   }
+  return -1;
 }
 
 void UserDefinedJointStatesModel::add(const QString& group_name,
@@ -92,57 +172,241 @@ void UserDefinedJointStatesModel::add(const QString& group_name,
 {
   QString state_name_trimmed = state_name.trimmed();
 
-  const auto& group_states = env_->getManipulatorManager()->getGroupJointStates();
-  auto group = group_states.find(group_name.toStdString());
-  bool add = true;
-
   tesseract_scene_graph::GroupsJointState state;
   for (int i = 0; i < joint_names.size(); ++i)
     state[joint_names[i].toStdString()] = joint_values[i].toDouble();
 
-  if (group != group_states.end())
-  {
-    auto s = group->second.find(state_name_trimmed.toStdString());
-    if (s != group->second.end())
-      add = false;
+  env_->getManipulatorManager()->addGroupJointState(group_name.toStdString(), state_name_trimmed.toStdString(), state);
 
-    env_->getManipulatorManager()->addGroupJointState(group_name.toStdString(), state_name_trimmed.toStdString(), state);
+  // A replaced state keeps its row, only its data changes
+  int row = findRow(group_name, state_name_trimmed);
+  if (row < 0)
+  {
+    row = rowCount();
+    beginInsertRows(QModelIndex(), row, row);
+    rows_.push_back({ group_name, state_name_trimmed, {} });
+    endInsertRows();
   }
   else
   {
-    tesseract_scene_graph::GroupsJointStates states;
-    states[state_name.toStdString()] = state;
-    env_->getManipulatorManager()->addGroupJointState(group_name.toStdString(), state_name_trimmed.toStdString(), state);
+    emit dataChanged(index(row), index(row), { JointNamesRole, JointValuesRole });
   }
 
-  QStandardItem *parent_item = this->invisibleRootItem();
-  if (add)
+  checkCollision(group_name, state_name_trimmed, state);
+}
+
+int UserDefinedJointStatesModel::importCSV(const QString& filepath)
+{
+  QFile file(filepath);
+  if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    return -1;
+
+  // Existing rows keep their collision results, only the imported states are inserted or updated
+  std::map<std::pair<QString, QString>, std::size_t> existing;
+  for (std::size_t row = 0; row < rows_.size(); ++row)
+    existing[std::make_pair(rows_[row].group_name, rows_[row].state_name)] = row;
+
+  std::vector<Row> new_rows;
+  std::vector<std::size_t> replaced_rows;
+
+  auto manager = env_->getManipulatorManager();
+  QTextStream stream(&file);
+  QString line;
+  int count {0};
+  int line_number {0};
+  while (stream.readLineInto(&line))
   {
-    auto item = new QStandardItem();
-    item->setData(group_name, UserDefinedJointStatesRoles::GroupNameRole );
-    item->setData(state_name_trimmed, UserDefinedJointStatesRoles::StateNameRole);
-    item->setData(joint_names.join(","), UserDefinedJointStatesRoles::JointNamesRole);
-    item->setData(joint_values.join(","), UserDefinedJointStatesRoles::JointValuesRole);
-    parent_item->appendRow(item);
+    ++line_number;
+    if (line.trimmed().isEmpty() || line.startsWith('#'))
+      continue;
+
+    QStringList fields = line.split(',');
+
+    if (fields.size() < 4 || (fields.size() % 2) != 0)
+    {
+      CONSOLE_BRIDGE_logError("Skipping invalid joint state on line %d of %s", line_number, filepath.toStdString().c_str());
+      continue;
+    }
+
+    bool ok = true;
+    tesseract_scene_graph::GroupsJointState state;
+    for (int i = 2; i < fields.size() && ok; i += 2)
+      state[fields[i].trimmed().toStdString()] = fields[i + 1].toDouble(&ok);
+
+    if (!ok)
+    {
+      CONSOLE_BRIDGE_logError("Skipping invalid joint value on line %d of %s", line_number, filepath.toStdString().c_str());
+      continue;
+    }
+
+    QString group_name = fields[0].trimmed();
+    QString state_name = fields[1].trimmed();
+    manager->addGroupJointState(group_name.toStdString(), state_name.toStdString(), state);
+    ++count;
+
+    auto key = std::make_pair(group_name, state_name);
+    auto it = existing.find(key);
+    if (it == existing.end())
+    {
+      existing[key] = rows_.size() + new_rows.size();
+      new_rows.push_back({ group_name, state_name, {} });
+    }
+    else if (it->second < rows_.size())
+    {
+      replaced_rows.push_back(it->second);
+    }
   }
-  else // replace
+
+  // The collision result of a replaced state no longer applies to its values
+  for (std::size_t row : replaced_rows)
   {
-    setEnvironment(env_);
+    Row& replaced = rows_[row];
+    pending_.erase(std::make_pair(replaced.group_name, replaced.state_name));
+    replaced.collision = CollisionCheckResult();
+    emit dataChanged(index(static_cast<int>(row)), index(static_cast<int>(row)));
   }
+
+  if (!new_rows.empty())
+  {
+    int first = rowCount();
+    beginInsertRows(QModelIndex(), first, first + static_cast<int>(new_rows.size()) - 1);
+    rows_.insert(rows_.end(), std::make_move_iterator(new_rows.begin()), std::make_move_iterator(new_rows.end()));
+    endInsertRows();
+  }
+
+  return count;
 }
 
-bool UserDefinedJointStatesModel::removeRows(int row, int count, const QModelIndex &parent)
+bool UserDefinedJointStatesModel::exportCSV(const QString& filepath) const
 {
-  if (row >= 0)
+  QFile file(filepath);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+    return false;
+
+  QTextStream stream(&file);
+  stream.setRealNumberPrecision(std::numeric_limits<double>::max_digits10);
+  for (const auto& group : env_->getManipulatorManager()->getGroupJointStates())
   {
-    QStandardItem *row_item = item(row);
-    QString group_name = row_item->data(UserDefinedJointStatesRoles::GroupNameRole).toString();
-    QString state_name = row_item->data(UserDefinedJointStatesRoles::StateNameRole).toString();
-    env_->getManipulatorManager()->removeGroupJointState(group_name.toStdString(), state_name.toStdString());
+    for (const auto& state : group.second)
+    {
+      stream << QString::fromStdString(group.first) << "," << QString::fromStdString(state.first);
+      for (const auto& v : state.second)
+        stream << "," << QString::fromStdString(v.first) << "," << v.second;
+      stream << "\n";
+    }
+  }
+
+  return stream.status() == QTextStream::Ok;
+}
+
+void UserDefinedJointStatesModel::checkCollision(const QString& group_name,
+                                                 const QString& state_name,
+                                                 const tesseract_scene_graph::GroupsJointState& state)
+{
+  // Drop the checks that are done, their futures would otherwise pile up
+  tasks_.erase(std::remove_if(tasks_.begin(), tasks_.end(), [](const std::future<void>& task) {
+    return task.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+  }), tasks_.end());
+
+  std::uint64_t task_id = ++last_task_id_;
+  pending_[std::make_pair(group_name, state_name)] = task_id;
+  setCollisionResult(group_name, state_name, { "Checking", "", "" });
+
+  // The contact manager and state solver are copies, and the matrix is copied so later edits do not race the check
+  tesseract_collision::DiscreteContactManager::Ptr contact_manager = env_->getDiscreteContactManager();
+  tesseract_environment::StateSolver::Ptr state_solver = env_->getStateSolver();
+  auto acm = std::make_shared<tesseract_scene_graph::AllowedCollisionMatrix>(*env_->getAllowedCollisionMatrix());
+  contact_manager->setIsContactAllowedFn([acm](const std::string& link_name1, const std::string& link_name2) {
+    return acm->isCollisionAllowed(link_name1, link_name2);
+  });
+  contact_manager->setContactDistanceThreshold(COLLISION_CHECK_DISTANCE);
+
+  std::unordered_map<std::string, double> joints(state.begin(), state.end());
+  tasks_.push_back(std::async(std::launch::async, [this, contact_manager, state_solver, joints, group_name, state_name, task_id]() {
+    tesseract_environment::EnvState::Ptr env_state = state_solver->getState(joints);
+    contact_manager->setCollisionObjectsTransform(env_state->link_transforms);
+
+    tesseract_collision::ContactResultMap results;
+    tesseract_collision::ContactRequest request;
+    request.type = tesseract_collision::ContactTestType::ALL;
+    contact_manager->contactTest(results, request);
 
-    return QStandardItemModel::removeRows(row, count, parent);
+    double min_distance = std::numeric_limits<double>::max();
+    QStringList pairs;
+    for (const auto& pair : results)
+    {
+      if (pair.second.empty())
+        continue;
+
+      double pair_distance = std::numeric_limits<double>::max();
+      for (const auto& contact : pair.second)
+        pair_distance = std::min(pair_distance, contact.distance);
+
+      min_distance = std::min(min_distance, pair_distance);
+      pairs.push_back(QString::fromStdString(pair.first.first) + "-" + QString::fromStdString(pair.first.second));
+    }
+
+    CollisionCheckResult result;
+    if (pairs.empty())
+    {
+      result.status = "Clear";
+      result.min_distance = ">" + QString::number(COLLISION_CHECK_DISTANCE);
+    }
+    else
+    {
+      result.status = (min_distance < 0) ? "Collision" : "Near";
+      result.min_distance = QString::number(min_distance);
+      result.pairs = pairs.join(",");
+    }
+
+    QMetaObject::invokeMethod(this, [this, group_name, state_name, task_id, result]() {
+      onCollisionChecked(group_name, state_name, task_id, result);
+    }, Qt::QueuedConnection);
+  }));
+}
+
+void UserDefinedJointStatesModel::onCollisionChecked(const QString& group_name,
+                                                     const QString& state_name,
+                                                     std::uint64_t task_id,
+                                                     const CollisionCheckResult& result)
+{
+  // Ignore the result if the state was removed or changed since the check started
+  auto it = pending_.find(std::make_pair(group_name, state_name));
+  if (it == pending_.end() || it->second != task_id)
+    return;
+
+  pending_.erase(it);
+  setCollisionResult(group_name, state_name, result);
+}
+
+void UserDefinedJointStatesModel::setCollisionResult(const QString& group_name,
+                                                     const QString& state_name,
+                                                     const CollisionCheckResult& result)
+{
+  int row = findRow(group_name, state_name);
+  if (row < 0)
+    return;
+
+  rows_[static_cast<std::size_t>(row)].collision = result;
+  emit dataChanged(index(row), index(row), { CollisionStatusRole, MinDistanceRole, CollisionPairsRole });
+}
+
+bool UserDefinedJointStatesModel::removeRows(int row, int count, const QModelIndex &parent)
+{
+  if (parent.isValid() || row < 0 || count <= 0 || (row + count) > rowCount())
+    return false;
+
+  for (int r = row; r < row + count; ++r)
+  {
+    const Row& state = rows_[static_cast<std::size_t>(r)];
+    pending_.erase(std::make_pair(state.group_name, state.state_name));
+    env_->getManipulatorManager()->removeGroupJointState(state.group_name.toStdString(), state.state_name.toStdString());
   }
-  return false;
+
+  beginRemoveRows(parent, row, row + count - 1);
+  rows_.erase(rows_.begin() + row, rows_.begin() + row + count);
+  endRemoveRows();
+  return true;
 }
 
 }
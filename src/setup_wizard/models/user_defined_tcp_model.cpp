@@ -1,6 +1,6 @@
 /**
  * @file user_defined_tcp_model.cpp
- * @brief A Qt Standard Item Model for User Defined Group Tool Center Points
+ * @brief A Qt List Model for User Defined Group Tool Center Points
  *
  * @author Levi Armstrong
  * @date May 14, 2020
@@ -26,24 +26,52 @@
 #include <tesseract_ignition/setup_wizard/models/user_defined_tcp_model.h>
 #include <Eigen/Geometry>
 #include <QVector3D>
+#include <QFile>
+#include <QTextStream>
+#include <limits>
 
 namespace tesseract_ignition
 {
 
+/** @brief Create a transform from a position and roll, pitch and yaw angles */
+static Eigen::Isometry3d toIsometry(const Eigen::Vector3d& xyz, const Eigen::Vector3d& rpy)
+{
+  Eigen::Isometry3d tcp = Eigen::Isometry3d::Identity();
+  tcp.translation() =  xyz;
+
+  Eigen::AngleAxisd rollAngle(rpy.x(), Eigen::Vector3d::UnitX());
+  Eigen::AngleAxisd pitchAngle(rpy.y(), Eigen::Vector3d::UnitY());
+  Eigen::AngleAxisd yawAngle(rpy.z(), Eigen::Vector3d::UnitZ());
+
+  tcp.linear() = Eigen::Quaterniond(yawAngle * pitchAngle * rollAngle).toRotationMatrix();
+  return tcp;
+}
+
+/** @brief Get the roll, pitch and yaw angles of a transform */
+static Eigen::Vector3d toRPY(const Eigen::Isometry3d& tcp)
+{
+  Eigen::Vector3d ypr = tcp.rotation().eulerAngles(2, 1, 0);
+  return Eigen::Vector3d(ypr.z(), ypr.y(), ypr.x());
+}
+
 UserDefinedTCPModel::UserDefinedTCPModel(QObject *parent)
-  : QStandardItemModel(parent)
+  : QAbstractListModel(parent)
 {
 }
 
 UserDefinedTCPModel::UserDefinedTCPModel(const UserDefinedTCPModel &other)
-  : QStandardItemModel(other.d_ptr->parent)
+  : QAbstractListModel(other.d_ptr->parent)
 {
   this->env_ = other.env_;
+  this->rows_ = other.rows_;
 }
 
 UserDefinedTCPModel &UserDefinedTCPModel::operator=(const UserDefinedTCPModel &other)
 {
+  beginResetModel();
   this->env_ = other.env_;
+  this->rows_ = other.rows_;
+  endResetModel();
   return *this;
 }
 
@@ -57,30 +85,86 @@ QHash<int, QByteArray> UserDefinedTCPModel::roleNames() const
     return roles;
 }
 
-void UserDefinedTCPModel::setEnvironment(tesseract_environment::Environment::Ptr env)
+int UserDefinedTCPModel::rowCount(const QModelIndex &parent) const
 {
-  this->clear();
-  env_ = env;
-  QStandardItem *parent_item = this->invisibleRootItem();
-  Eigen::IOFormat eigen_format(Eigen::StreamPrecision, 0, ",", ",");
-  for (const auto& group : env_->getManipulatorManager()->getGroupTCPs())
+  if (parent.isValid())
+    return 0;
+
+  return static_cast<int>(rows_.size());
+}
+
+QVariant UserDefinedTCPModel::data(const QModelIndex &index, int role) const
+{
+  if (!index.isValid() || index.row() < 0 || index.row() >= rowCount())
+    return QVariant();
+
+  const Row& row = rows_[static_cast<std::size_t>(index.row())];
+  switch (role)
   {
-    for (const auto& tcp : group.second)
+    case Qt::DisplayRole:
+    case GroupNameRole:
+      return row.group_name;
+    case TCPNameRole:
+      return row.tcp_name;
+    case PositionRole:
+    case OrientationRole:
     {
+      const auto& group_tcps = env_->getManipulatorManager()->getGroupTCPs();
+      auto group = group_tcps.find(row.group_name.toStdString());
+      if (group == group_tcps.end())
+        return QVariant();
 
-      auto item = new QStandardItem();
-      item->setData(QString::fromStdString(group.first), UserDefinedTCPRoles::GroupNameRole);
-      item->setData(QString::fromStdString(tcp.first), UserDefinedTCPRoles::TCPNameRole);
+      auto tcp = group->second.find(row.tcp_name.toStdString());
+      if (tcp == group->second.end())
+        return QVariant();
 
-      std::stringstream xyz_string, rpy_string;
-      xyz_string << tcp.second.translation().format(eigen_format);
-      rpy_string << tcp.second.rotation().eulerAngles(2, 1, 0).format(eigen_format);
+      Eigen::IOFormat eigen_format(Eigen::StreamPrecision, 0, ",", ",");
+      std::stringstream ss;
+      if (role == PositionRole)
+        ss << tcp->second.translation().format(eigen_format);
+      else
+        ss << toRPY(tcp->second).format(eigen_format);
 
-      item->setData(QString::fromStdString(xyz_string.str()), UserDefinedTCPRoles::PositionRole);
-      item->setData(QString::fromStdString(rpy_string.str()), UserDefinedTCPRoles::OrientationRole);
-      parent_item->appendRow(item);
+      return QString::fromStdString(ss.str());
     }
+    default:
+      return QVariant();
+  }
+}
+
+void UserDefinedTCPModel::resetRows()
+{
+  beginResetModel();
+  rows_.clear();
+  for (const auto& group : env_->getManipulatorManager()->getGroupTCPs())
+  {
+    for (const auto& tcp : group.second)
+      rows_.push_back({ QString::fromStdString(group.first), QString::fromStdString(tcp.first) });
+  }
+  endResetModel();
+}
+
+void UserDefinedTCPModel::setEnvironment(tesseract_environment::Environment::Ptr env)
+{
+  env_ = env;
+  resetRows();
+}
+
+void UserDefinedTCPModel::clear()
+{
+  beginResetModel();
+  rows_.clear();
+  endResetModel();
+}
+
+int UserDefinedTCPModel::findRow(const QString& group_name, const QString& tcp_name) const
+{
+  for (std::size_t row = 0; row < rows_.size(); ++row)
+  {
+    if (rows_[row].group_name == group_name && rows_[row].tcp_name == tcp_name)
+      return static_cast<int>(row);
   }
+  return -1;
 }
 
 void UserDefinedTCPModel::add(const QString& group_name,
@@ -90,69 +174,110 @@ void UserDefinedTCPModel::add(const QString& group_name,
 {
   QString tcp_name_trimmed = tcp_name.trimmed();
 
-  const auto& group_tcps = env_->getManipulatorManager()->getGroupTCPs();
-  auto group = group_tcps.find(group_name.toStdString());
-  bool add = true;
-
-  Eigen::IOFormat eigen_format(Eigen::StreamPrecision, 0, ",", ",");
-  Eigen::Isometry3d tcp = Eigen::Isometry3d::Identity();
   Eigen::Vector3d xyz = Eigen::Vector3f(position.x(), position.y(), position.z()).cast<double>();
   Eigen::Vector3d rpy = Eigen::Vector3f(orientation.x(), orientation.y(), orientation.z()).cast<double>();
+  env_->getManipulatorManager()->addGroupTCP(group_name.toStdString(), tcp_name_trimmed.toStdString(), toIsometry(xyz, rpy));
 
-  tcp.translation() =  xyz;
-
-  Eigen::AngleAxisd rollAngle(rpy.x(), Eigen::Vector3d::UnitX());
-  Eigen::AngleAxisd pitchAngle(rpy.y(), Eigen::Vector3d::UnitY());
-  Eigen::AngleAxisd yawAngle(rpy.z(), Eigen::Vector3d::UnitZ());
-
-  tcp.linear() = Eigen::Quaterniond(yawAngle * pitchAngle * rollAngle).toRotationMatrix();
-
-  if (group != group_tcps.end())
+  int row = findRow(group_name, tcp_name_trimmed);
+  if (row < 0)
   {
-    auto s = group->second.find(tcp_name_trimmed.toStdString());
-    if (s != group->second.end())
-      add = false;
-
-    env_->getManipulatorManager()->addGroupTCP(group_name.toStdString(), tcp_name.toStdString(), tcp);
+    row = rowCount();
+    beginInsertRows(QModelIndex(), row, row);
+    rows_.push_back({ group_name, tcp_name_trimmed });
+    endInsertRows();
   }
-  else
+  else // replace
   {
-    env_->getManipulatorManager()->addGroupTCP(group_name.toStdString(), tcp_name.toStdString(), tcp);
+    emit dataChanged(index(row), index(row), { PositionRole, OrientationRole });
   }
+}
 
-  QStandardItem *parent_item = this->invisibleRootItem();
-  if (add)
+int UserDefinedTCPModel::importCSV(const QString& filepath)
+{
+  QFile file(filepath);
+  if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    return -1;
+
+  auto manager = env_->getManipulatorManager();
+  QTextStream stream(&file);
+  QString line;
+  int count {0};
+  int line_number {0};
+  while (stream.readLineInto(&line))
   {
-    auto item = new QStandardItem();
-    item->setData(group_name, UserDefinedTCPRoles::GroupNameRole);
-    item->setData(tcp_name_trimmed,  UserDefinedTCPRoles::TCPNameRole);
+    ++line_number;
+    if (line.trimmed().isEmpty() || line.startsWith('#'))
+      continue;
 
-    std::stringstream xyz_string, rpy_string;
-    xyz_string << xyz.format(eigen_format);
-    rpy_string << rpy.format(eigen_format);
+    QStringList fields = line.split(',');
+    if (fields.size() != 8)
+    {
+      CONSOLE_BRIDGE_logError("Skipping invalid tool center point on line %d of %s", line_number, filepath.toStdString().c_str());
+      continue;
+    }
+
+    bool ok = true;
+    Eigen::VectorXd values(6);
+    for (int i = 0; i < 6 && ok; ++i)
+      values(i) = fields[i + 2].toDouble(&ok);
+
+    if (!ok)
+    {
+      CONSOLE_BRIDGE_logError("Skipping invalid tool center point value on line %d of %s", line_number, filepath.toStdString().c_str());
+      continue;
+    }
 
-    item->setData(QString::fromStdString(xyz_string.str()), UserDefinedTCPRoles::PositionRole);
-    item->setData(QString::fromStdString(rpy_string.str()), UserDefinedTCPRoles::OrientationRole);
-    parent_item->appendRow(item);
+    manager->addGroupTCP(fields[0].trimmed().toStdString(),
+                         fields[1].trimmed().toStdString(),
+                         toIsometry(values.head<3>(), values.tail<3>()));
+    ++count;
   }
-  else // replace
+
+  resetRows();
+  return count;
+}
+
+bool UserDefinedTCPModel::exportCSV(const QString& filepath) const
+{
+  QFile file(filepath);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+    return false;
+
+  QTextStream stream(&file);
+  stream.setRealNumberPrecision(std::numeric_limits<double>::max_digits10);
+  for (const auto& group : env_->getManipulatorManager()->getGroupTCPs())
   {
-    setEnvironment(env_);
+    for (const auto& tcp : group.second)
+    {
+      Eigen::Vector3d xyz = tcp.second.translation();
+      Eigen::Vector3d rpy = toRPY(tcp.second);
+      stream << QString::fromStdString(group.first) << "," << QString::fromStdString(tcp.first);
+      for (Eigen::Index i = 0; i < 3; ++i)
+        stream << "," << xyz(i);
+      for (Eigen::Index i = 0; i < 3; ++i)
+        stream << "," << rpy(i);
+      stream << "\n";
+    }
   }
+
+  return stream.status() == QTextStream::Ok;
 }
 
 bool UserDefinedTCPModel::removeRows(int row, int count, const QModelIndex &parent)
 {
-  if (row >= 0)
-  {
-    QStandardItem *row_item = item(row);
-    QString group_name = row_item->data(UserDefinedTCPRoles::GroupNameRole).toString();
-    QString tcp_name = row_item->data(UserDefinedTCPRoles::TCPNameRole).toString();
-    this->env_->getManipulatorManager()->removeGroupTCP(group_name.toStdString(), tcp_name.toStdString());
+  if (parent.isValid() || row < 0 || count <= 0 || (row + count) > rowCount())
+    return false;
 
-    return QStandardItemModel::removeRows(row, count, parent);
+  for (int r = row; r < row + count; ++r)
+  {
+    const Row& tcp = rows_[static_cast<std::size_t>(r)];
+    env_->getManipulatorManager()->removeGroupTCP(tcp.group_name.toStdString(), tcp.tcp_name.toStdString());
   }
-  return false;
+
+  beginRemoveRows(parent, row, row + count - 1);
+  rows_.erase(rows_.begin() + row, rows_.begin() + row + count);
+  endRemoveRows();
+  return true;
 }
 
 }
@@ -0,0 +1,619 @@
+/**
+ * @file opw_parameter_fit.cpp
+ * @brief Utilities for fitting and validating OPW kinematic parameters against the kinematic chain of a group
+ *
+ * @author Levi Armstrong
+ * @date October 18, 2026
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @copyright Copyright (c) 2020, Southwest Research Institute
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <tesseract_ignition/setup_wizard/opw_parameter_fit.h>
+#include <opw_kinematics/opw_kinematics.h>
+#include <opw_kinematics/opw_utilities.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <future>
+#include <limits>
+#include <random>
+#include <thread>
+
+namespace tesseract_ignition
+{
+
+namespace
+{
+/** @brief The number of continuous parameters, a1, a2, b, c1, c2, c3, c4 and the six offsets */
+constexpr Eigen::Index PARAMETER_COUNT = 13;
+
+/** @brief The number of residuals of each sample, three for position and three for orientation */
+constexpr Eigen::Index SAMPLE_RESIDUALS = 6;
+
+using SignCorrections = std::array<signed char, 6>;
+
+/** @brief A joint state of the chain and the pose its forward kinematics gives */
+struct FitSample
+{
+  Eigen::VectorXd joint_values;
+  Eigen::Isometry3d pose;
+};
+
+/** @brief A starting point of the least squares fit */
+struct FitCandidate
+{
+  Eigen::VectorXd x;
+  SignCorrections sign_corrections;
+  double cost {std::numeric_limits<double>::max()};
+};
+
+opw_kinematics::Parameters<double> toOPW(const Eigen::VectorXd& x, const SignCorrections& sign_corrections)
+{
+  opw_kinematics::Parameters<double> p;
+  p.a1 = x(0);
+  p.a2 = x(1);
+  p.b = x(2);
+  p.c1 = x(3);
+  p.c2 = x(4);
+  p.c3 = x(5);
+  p.c4 = x(6);
+  for (std::size_t i = 0; i < 6; ++i)
+  {
+    p.offsets[i] = x(7 + static_cast<Eigen::Index>(i));
+    p.sign_corrections[i] = sign_corrections[i];
+  }
+  return p;
+}
+
+opw_kinematics::Parameters<double> toOPW(const tesseract_scene_graph::OPWKinematicParameters& parameters)
+{
+  opw_kinematics::Parameters<double> p;
+  p.a1 = parameters.a1;
+  p.a2 = parameters.a2;
+  p.b = parameters.b;
+  p.c1 = parameters.c1;
+  p.c2 = parameters.c2;
+  p.c3 = parameters.c3;
+  p.c4 = parameters.c4;
+  for (std::size_t i = 0; i < 6; ++i)
+  {
+    p.offsets[i] = parameters.offsets[i];
+    p.sign_corrections[i] = parameters.sign_corrections[i];
+  }
+  return p;
+}
+
+/** @brief Wrap an angle to (-pi, pi] */
+double wrapAngle(double angle)
+{
+  angle = std::remainder(angle, 2.0 * M_PI);
+  return (angle <= -M_PI) ? angle + 2.0 * M_PI : angle;
+}
+
+/** @brief The rotation vector taking the target orientation to the actual one */
+Eigen::Vector3d rotationError(const Eigen::Matrix3d& target, const Eigen::Matrix3d& actual)
+{
+  Eigen::AngleAxisd error(target.transpose() * actual);
+  return error.angle() * error.axis();
+}
+
+/** @brief Compute the position and orientation residuals of the OPW model over the samples */
+void computeResiduals(Eigen::VectorXd& residuals,
+                      const Eigen::VectorXd& x,
+                      const SignCorrections& sign_corrections,
+                      const std::vector<FitSample>& samples)
+{
+  opw_kinematics::Parameters<double> p = toOPW(x, sign_corrections);
+  residuals.resize(static_cast<Eigen::Index>(samples.size()) * SAMPLE_RESIDUALS);
+  for (std::size_t i = 0; i < samples.size(); ++i)
+  {
+    Eigen::Isometry3d pose = opw_kinematics::forward(p, samples[i].joint_values.data());
+    auto r = residuals.segment<SAMPLE_RESIDUALS>(static_cast<Eigen::Index>(i) * SAMPLE_RESIDUALS);
+    r.head<3>() = pose.translation() - samples[i].pose.translation();
+    r.tail<3>() = rotationError(samples[i].pose.linear(), pose.linear());
+  }
+}
+
+/**
+ * @brief Minimize the squared residuals with Levenberg-Marquardt using a forward difference Jacobian
+ * @return The final sum of squared residuals
+ */
+double levenbergMarquardt(Eigen::VectorXd& x,
+                          const SignCorrections& sign_corrections,
+                          const std::vector<FitSample>& samples,
+                          int iterations)
+{
+  Eigen::VectorXd residuals, trial_residuals;
+  computeResiduals(residuals, x, sign_corrections, samples);
+  double cost = residuals.squaredNorm();
+
+  Eigen::MatrixXd jacobian(residuals.size(), PARAMETER_COUNT);
+  double lambda = 1e-3;
+  for (int iteration = 0; iteration < iterations && cost > 1e-20; ++iteration)
+  {
+    for (Eigen::Index j = 0; j < PARAMETER_COUNT; ++j)
+    {
+      double h = 1e-7 * std::max(1.0, std::abs(x(j)));
+      Eigen::VectorXd xh = x;
+      xh(j) += h;
+      computeResiduals(trial_residuals, xh, sign_corrections, samples);
+      jacobian.col(j) = (trial_residuals - residuals) / h;
+    }
+
+    Eigen::MatrixXd jtj = jacobian.transpose() * jacobian;
+    Eigen::VectorXd jtr = jacobian.transpose() * residuals;
+
+    bool improved = false;
+    while (!improved && lambda < 1e10)
+    {
+      Eigen::MatrixXd a = jtj;
+      a.diagonal() += lambda * (jtj.diagonal().array() + 1e-12).matrix();
+      Eigen::VectorXd step = a.ldlt().solve(-jtr);
+      if (!step.allFinite())
+      {
+        lambda *= 10;
+        continue;
+      }
+
+      Eigen::VectorXd trial = x + step;
+      computeResiduals(trial_residuals, trial, sign_corrections, samples);
+      double trial_cost = trial_residuals.squaredNorm();
+      if (std::isfinite(trial_cost) && trial_cost < cost)
+      {
+        improved = true;
+        bool converged = (step.norm() < 1e-12 * (1.0 + x.norm()));
+        x = trial;
+        residuals = trial_residuals;
+        cost = trial_cost;
+        lambda = std::max(lambda / 10, 1e-12);
+        if (converged)
+          return cost;
+      }
+      else
+      {
+        lambda *= 10;
+      }
+    }
+
+    if (!improved)
+      break;
+  }
+
+  return cost;
+}
+
+/** @brief Sample joint states uniformly within the limits and compute their poses */
+std::vector<FitSample> sampleChain(const tesseract_kinematics::ForwardKinematics& fwd_kin,
+                                   const Eigen::MatrixX2d& limits,
+                                   long count,
+                                   std::mt19937& rng)
+{
+  std::vector<FitSample> samples;
+  samples.reserve(static_cast<std::size_t>(std::max(count, 0L)));
+  std::uniform_real_distribution<double> unit(0.0, 1.0);
+  for (long i = 0; i < count; ++i)
+  {
+    FitSample sample;
+    sample.joint_values.resize(limits.rows());
+    for (Eigen::Index j = 0; j < limits.rows(); ++j)
+      sample.joint_values(j) = limits(j, 0) + unit(rng) * (limits(j, 1) - limits(j, 0));
+
+    if (fwd_kin.calcFwdKin(sample.pose, sample.joint_values))
+      samples.push_back(sample);
+  }
+  return samples;
+}
+
+/** @brief Get the point on the first line closest to the second line, or the first origin if they are parallel */
+Eigen::Vector3d closestPoint(const OPWJointFrame& l1, const OPWJointFrame& l2)
+{
+  Eigen::Vector3d w = l1.origin - l2.origin;
+  double b = l1.axis.dot(l2.axis);
+  double denom = 1.0 - b * b;
+  if (denom < 1e-9)
+    return l1.origin;
+
+  double t = (b * l2.axis.dot(w) - l1.axis.dot(w)) / denom;
+  return l1.origin + t * l1.axis;
+}
+
+/** @brief Add both signs of an angle to a list of starting offsets */
+std::vector<double> signedStarts(double angle)
+{
+  if (std::abs(angle) < 1e-6)
+    return { 0.0 };
+
+  return { angle, -angle };
+}
+
+/** @brief Build the starting points of the fit from the geometry of the chain in the zero state */
+std::vector<FitCandidate> createCandidates(const std::vector<OPWJointFrame>& frames,
+                                           const Eigen::Isometry3d& zero_pose,
+                                           signed char sign1)
+{
+  const Eigen::Vector3d z = Eigen::Vector3d::UnitZ();
+  const Eigen::Vector3d& p2 = frames[1].origin;
+  const Eigen::Vector3d& p3 = frames[2].origin;
+  Eigen::Vector3d axis2 = frames[1].axis.normalized();
+  Eigen::Vector3d wrist_center = closestPoint(frames[3], frames[4]);
+
+  // Link two, from the shoulder to the elbow, perpendicular to the shoulder axis
+  Eigen::Vector3d upper_arm = p3 - p2;
+  upper_arm -= upper_arm.dot(axis2) * axis2;
+  double c2 = upper_arm.norm();
+  Eigen::Vector3d u = (c2 > 1e-9) ? Eigen::Vector3d(upper_arm / c2) : z;
+  Eigen::Vector3d f = axis2.cross(u);
+
+  // The forearm, from the elbow to the wrist center, split into the part along and across link two
+  Eigen::Vector3d forearm = wrist_center - p3;
+  forearm -= forearm.dot(axis2) * axis2;
+  double along = forearm.dot(u);
+  double across = forearm.dot(f);
+
+  // OPW expects the forearm to continue along link two at zero, so the elbow angle is taken out in steps of
+  // ninety degrees and left to the offset of joint three
+  double elbow = std::round(std::atan2(across, along) / M_PI_2) * M_PI_2;
+  double c3 = std::cos(elbow) * along + std::sin(elbow) * across;
+  double a2 = -std::sin(elbow) * along + std::cos(elbow) * across;
+
+  Eigen::Vector3d forward(wrist_center.x(), wrist_center.y(), 0);
+  forward -= forward.dot(axis2) * axis2;
+
+  Eigen::VectorXd x(PARAMETER_COUNT);
+  x.setZero();
+  x(0) = Eigen::Vector2d(p2.x(), p2.y()).norm();
+  x(1) = a2;
+  x(2) = wrist_center.dot(axis2);
+  x(3) = p2.z();
+  x(4) = c2;
+  x(5) = c3;
+  x(6) = (zero_pose.translation() - wrist_center).norm();
+
+  double shoulder = std::atan2(u.dot(axis2.cross(z)), u.dot(z));
+  double base = (forward.norm() > 1e-9) ? std::atan2(forward.y(), forward.x()) : 0.0;
+
+  std::vector<FitCandidate> candidates;
+  for (unsigned signs = 0; signs < 32; ++signs)
+  {
+    SignCorrections sign_corrections { sign1, 1, 1, 1, 1, 1 };
+    for (std::size_t i = 1; i < 6; ++i)
+      sign_corrections[i] = ((signs >> (i - 1)) & 1U) ? -1 : 1;
+
+    for (double o1 : signedStarts(base))
+    {
+      for (double o2 : signedStarts(shoulder))
+      {
+        for (double o3 : signedStarts(elbow))
+        {
+          FitCandidate candidate;
+          candidate.x = x;
+          candidate.x(7) = o1;
+          candidate.x(8) = o2;
+          candidate.x(9) = o3;
+          candidate.sign_corrections = sign_corrections;
+          candidates.push_back(candidate);
+        }
+      }
+    }
+  }
+  return candidates;
+}
+
+unsigned getThreadCount(const OPWFitConfig& config)
+{
+  if (config.threads > 0)
+    return config.threads;
+
+  return std::max(1U, std::thread::hardware_concurrency());
+}
+
+/** @brief Get the value at the given fraction of a sorted list */
+double percentile(const std::vector<double>& sorted, double fraction)
+{
+  if (sorted.empty())
+    return 0;
+
+  auto index = static_cast<std::size_t>(std::ceil(fraction * static_cast<double>(sorted.size())));
+  return sorted[std::min(std::max(index, std::size_t(1)), sorted.size()) - 1];
+}
+
+double mean(const std::vector<double>& values)
+{
+  if (values.empty())
+    return 0;
+
+  double sum = 0;
+  for (double v : values)
+    sum += v;
+  return sum / static_cast<double>(values.size());
+}
+}
+
+double OPWValidationResult::getSuccessRate() const
+{
+  return (samples > 0) ? static_cast<double>(successes) / static_cast<double>(samples) : 0.0;
+}
+
+std::vector<OPWJointFrame> getOPWJointFrames(const tesseract_environment::Environment& env,
+                                             const tesseract_kinematics::ForwardKinematics& fwd_kin)
+{
+  const std::vector<std::string>& joint_names = fwd_kin.getJointNames();
+  auto state = env.getStateSolver()->getState(joint_names, Eigen::VectorXd::Zero(static_cast<Eigen::Index>(joint_names.size())));
+  auto scene_graph = env.getSceneGraph();
+
+  auto base = state->link_transforms.find(fwd_kin.getBaseLinkName());
+  if (base == state->link_transforms.end())
+    return {};
+
+  Eigen::Isometry3d base_inv = base->second.inverse();
+
+  std::vector<OPWJointFrame> frames;
+  frames.reserve(joint_names.size());
+  for (const auto& joint_name : joint_names)
+  {
+    auto joint = scene_graph->getJoint(joint_name);
+    if (joint == nullptr)
+      return {};
+
+    auto parent = state->link_transforms.find(joint->parent_link_name);
+    if (parent == state->link_transforms.end())
+      return {};
+
+    Eigen::Isometry3d joint_frame = base_inv * parent->second * joint->parent_to_joint_origin_transform;
+
+    OPWJointFrame frame;
+    frame.origin = joint_frame.translation();
+    frame.axis = (joint_frame.linear() * joint->axis).normalized();
+    frames.push_back(frame);
+  }
+
+  return frames;
+}
+
+Eigen::MatrixX2d getOPWJointLimits(const tesseract_environment::Environment& env,
+                                   const tesseract_kinematics::ForwardKinematics& fwd_kin)
+{
+  const std::vector<std::string>& joint_names = fwd_kin.getJointNames();
+  auto scene_graph = env.getSceneGraph();
+
+  Eigen::MatrixX2d limits(static_cast<Eigen::Index>(joint_names.size()), 2);
+  for (std::size_t i = 0; i < joint_names.size(); ++i)
+  {
+    auto row = static_cast<Eigen::Index>(i);
+    auto joint = scene_graph->getJoint(joint_names[i]);
+    if (joint != nullptr && joint->limits != nullptr && joint->limits->lower < joint->limits->upper)
+    {
+      limits(row, 0) = joint->limits->lower;
+      limits(row, 1) = joint->limits->upper;
+    }
+    else
+    {
+      limits(row, 0) = -M_PI;
+      limits(row, 1) = M_PI;
+    }
+  }
+  return limits;
+}
+
+OPWValidationResult validateOPWParameters(const tesseract_kinematics::ForwardKinematics& fwd_kin,
+                                          const Eigen::MatrixX2d& limits,
+                                          const tesseract_scene_graph::OPWKinematicParameters& parameters,
+                                          const OPWFitConfig& config)
+{
+  /** @brief The errors found by one thread */
+  struct ChunkResult
+  {
+    std::vector<double> position_errors;
+    std::vector<double> orientation_errors;
+    long samples {0};
+    long successes {0};
+    long no_solution {0};
+  };
+
+  const opw_kinematics::Parameters<double> p = toOPW(parameters);
+  unsigned thread_count = getThreadCount(config);
+  long chunk_size = (config.validation_samples + static_cast<long>(thread_count) - 1) / static_cast<long>(thread_count);
+
+  std::vector<std::future<ChunkResult>> chunks;
+  for (unsigned t = 0; t < thread_count; ++t)
+  {
+    long count = std::min(chunk_size, config.validation_samples - static_cast<long>(t) * chunk_size);
+    if (count <= 0)
+      break;
+
+    tesseract_kinematics::ForwardKinematics::Ptr kin = fwd_kin.clone();
+    std::uint32_t seed = config.seed + t;
+    chunks.push_back(std::async(std::launch::async, [kin, limits, p, count, seed, &config]() {
+      ChunkResult result;
+      std::mt19937 rng(seed);
+      std::vector<FitSample> samples = sampleChain(*kin, limits, count, rng);
+      result.position_errors.reserve(samples.size());
+      result.orientation_errors.reserve(samples.size());
+
+      std::array<double, 6 * 8> solutions;
+      Eigen::Isometry3d pose;
+      for (const auto& sample : samples)
+      {
+        ++result.samples;
+        opw_kinematics::inverse(p, sample.pose, solutions.data());
+
+        bool found = false;
+        double best_position = std::numeric_limits<double>::max();
+        double best_orientation = std::numeric_limits<double>::max();
+        for (std::size_t i = 0; i < 8; ++i)
+        {
+          double* solution = solutions.data() + 6 * i;
+          if (!opw_kinematics::isValid(solution))
+            continue;
+
+          if (!kin->calcFwdKin(pose, Eigen::Map<const Eigen::VectorXd>(solution, 6)))
+            continue;
+
+          double position = (pose.translation() - sample.pose.translation()).norm();
+          double orientation = rotationError(sample.pose.linear(), pose.linear()).norm();
+          if (!found || (position + orientation) < (best_position + best_orientation))
+          {
+            best_position = position;
+            best_orientation = orientation;
+            found = true;
+          }
+        }
+
+        if (!found)
+        {
+          ++result.no_solution;
+          continue;
+        }
+
+        result.position_errors.push_back(best_position);
+        result.orientation_errors.push_back(best_orientation);
+        if (best_position <= config.position_tolerance && best_orientation <= config.orientation_tolerance)
+          ++result.successes;
+      }
+      return result;
+    }));
+  }
+
+  OPWValidationResult result;
+  std::vector<double> position_errors;
+  std::vector<double> orientation_errors;
+  for (auto& chunk : chunks)
+  {
+    ChunkResult r = chunk.get();
+    result.samples += r.samples;
+    result.successes += r.successes;
+    result.no_solution += r.no_solution;
+    position_errors.insert(position_errors.end(), r.position_errors.begin(), r.position_errors.end());
+    orientation_errors.insert(orientation_errors.end(), r.orientation_errors.begin(), r.orientation_errors.end());
+  }
+
+  std::sort(position_errors.begin(), position_errors.end());
+  std::sort(orientation_errors.begin(), orientation_errors.end());
+  result.position_mean = mean(position_errors);
+  result.position_p95 = percentile(position_errors, 0.95);
+  result.position_max = position_errors.empty() ? 0 : position_errors.back();
+  result.orientation_mean = mean(orientation_errors);
+  result.orientation_p95 = percentile(orientation_errors, 0.95);
+  result.orientation_max = orientation_errors.empty() ? 0 : orientation_errors.back();
+  return result;
+}
+
+OPWFitResult fitOPWParameters(const tesseract_kinematics::ForwardKinematics& fwd_kin,
+                              const Eigen::MatrixX2d& limits,
+                              const std::vector<OPWJointFrame>& frames,
+                              const OPWFitConfig& config)
+{
+  OPWFitResult result;
+  if (frames.size() != 6 || limits.rows() != 6 || fwd_kin.getJointNames().size() != 6)
+  {
+    result.message = "OPW kinematics requires a chain of six joints";
+    return result;
+  }
+
+  if (std::abs(frames[0].axis.z()) < 1.0 - 1e-6)
+  {
+    result.message = "OPW kinematics requires the first joint to rotate about the z axis of the base link";
+    return result;
+  }
+
+  Eigen::Isometry3d zero_pose;
+  if (!fwd_kin.calcFwdKin(zero_pose, Eigen::VectorXd::Zero(6)))
+  {
+    result.message = "Failed to compute the forward kinematics of the chain";
+    return result;
+  }
+
+  std::mt19937 rng(config.seed);
+  std::vector<FitSample> screen_samples = sampleChain(fwd_kin, limits, config.screen_samples, rng);
+  std::vector<FitSample> fit_samples = sampleChain(fwd_kin, limits, config.fit_samples, rng);
+  if (screen_samples.empty() || fit_samples.empty())
+  {
+    result.message = "Failed to sample the forward kinematics of the chain";
+    return result;
+  }
+
+  // Screen every candidate with a short fit, split across threads
+  signed char sign1 = (frames[0].axis.z() > 0) ? 1 : -1;
+  std::vector<FitCandidate> candidates = createCandidates(frames, zero_pose, sign1);
+  unsigned thread_count = std::min(getThreadCount(config), static_cast<unsigned>(candidates.size()));
+  std::vector<std::future<void>> tasks;
+  for (unsigned t = 0; t < thread_count; ++t)
+  {
+    tasks.push_back(std::async(std::launch::async, [t, thread_count, &candidates, &screen_samples, &config]() {
+      for (std::size_t i = t; i < candidates.size(); i += thread_count)
+        candidates[i].cost = levenbergMarquardt(candidates[i].x, candidates[i].sign_corrections, screen_samples, config.screen_iterations);
+    }));
+  }
+  for (auto& task : tasks)
+    task.wait();
+
+  auto best = std::min_element(candidates.begin(), candidates.end(), [](const FitCandidate& a, const FitCandidate& b) {
+    return a.cost < b.cost;
+  });
+
+  // Refine the best candidate on the full sample set
+  Eigen::VectorXd x = best->x;
+  levenbergMarquardt(x, best->sign_corrections, fit_samples, config.fit_iterations);
+
+  Eigen::VectorXd residuals;
+  computeResiduals(residuals, x, best->sign_corrections, fit_samples);
+  double position_sum = 0;
+  double orientation_sum = 0;
+  for (std::size_t i = 0; i < fit_samples.size(); ++i)
+  {
+    auto r = residuals.segment<SAMPLE_RESIDUALS>(static_cast<Eigen::Index>(i) * SAMPLE_RESIDUALS);
+    position_sum += r.head<3>().squaredNorm();
+    orientation_sum += r.tail<3>().squaredNorm();
+  }
+  result.position_rms = std::sqrt(position_sum / static_cast<double>(fit_samples.size()));
+  result.orientation_rms = std::sqrt(orientation_sum / static_cast<double>(fit_samples.size()));
+
+  result.parameters.a1 = x(0);
+  result.parameters.a2 = x(1);
+  result.parameters.b = x(2);
+  result.parameters.c1 = x(3);
+  result.parameters.c2 = x(4);
+  result.parameters.c3 = x(5);
+  result.parameters.c4 = x(6);
+  for (std::size_t i = 0; i < 6; ++i)
+  {
+    result.parameters.offsets[i] = wrapAngle(x(7 + static_cast<Eigen::Index>(i)));
+    result.parameters.sign_corrections[i] = best->sign_corrections[i];
+  }
+
+  result.validation = validateOPWParameters(fwd_kin, limits, result.parameters, config);
+  if (result.position_rms > config.position_tolerance || result.orientation_rms > config.orientation_tolerance)
+  {
+    result.message = "The chain could not be fit with OPW kinematics, it may not be an OPW manipulator";
+    return result;
+  }
+
+  // A small fit error is not enough, the parameters must also solve IK for the poses of the chain
+  if (result.validation.getSuccessRate() < config.min_success_rate)
+  {
+    result.message = "The fitted parameters failed the IK and FK round trip validation";
+    return result;
+  }
+
+  result.success = true;
+
+  return result;
+}
+
+}
@@ -17,6 +17,8 @@
 #include <tesseract_ignition/setup_wizard/models/user_defined_joint_states_model.h>
 #include <tesseract_ignition/setup_wizard/models/user_defined_tcp_model.h>
 #include <tesseract_ignition/setup_wizard/models/opw_kinematics_model.h>
+#include <tesseract_ignition/setup_wizard/acm_generator.h>
+#include <tesseract_ignition/setup_wizard/allowed_collision_matrix_view.h>
 #include <tesseract_ignition/render_utils.h>
 #include <tesseract_ignition/gui_events.h>
 #include <tesseract_ignition/conversions.h>
@@ -28,6 +30,9 @@
 #include <tesseract_visualization/ignition/entity_manager.h>
 #include <memory>
 #include <QMetaObject>
+#include <QStandardPaths>
+#include <QDir>
+#include <QUrl>
 
 
 Q_DECLARE_SMART_POINTER_METATYPE(std::shared_ptr);
@@ -36,7 +41,12 @@ const QString CHAIN_GROUP = "Chain";
 const QString JOINT_LIST_GROUP = "Joint List";
 const QString LINK_LIST_GROUP = "Link List";
 
-static std::unordered_map<std::string, std::string> cache_package_paths;
+/** @brief Convert a file url from a QML FileDialog to a local file path, plain paths are returned unchanged */
+static QString toLocalFilePath(const QString& filepath)
+{
+  QUrl url(filepath);
+  return url.isLocalFile() ? url.toLocalFile() : filepath;
+}
 
 namespace tesseract_ignition::gui::plugins
 {
@@ -56,6 +66,12 @@ public:
 
   tesseract_ignition::RenderUtil render_util;
 
+  /** @brief The render util scene revision last announced with a SceneGraphLoaded event */
+  int scene_revision {0};
+
+  /** @brief The render util selection revision last announced with an EntitiesSelected event */
+  int selection_revision {0};
+
   QStringListModel link_model;
 
   JointListModel joint_model;
@@ -98,6 +114,8 @@ TesseractSetupWizard::TesseractSetupWizard()
   ignition::gui::App()->Engine()->rootContext()->setContextProperty("linkListViewModel", &this->data_->group_link_list_model);
   ignition::gui::App()->Engine()->rootContext()->setContextProperty("jointListViewModel", &this->data_->group_joint_list_model);
   ignition::gui::App()->Engine()->rootContext()->setContextProperty("opwKinematicsModel", &this->data_->opw_kinematics_model);
+
+  qmlRegisterType<AllowedCollisionMatrixView>("AllowedCollisionMatrixView", 1, 0, "AllowedCollisionMatrixView");
 }
 
 /////////////////////////////////////////////////
@@ -294,7 +312,7 @@ void TesseractSetupWizard::onRemoveKinematicGroup(int index)
 {
   if (index >= 0)
   {
-    QString group_name = this->data_->kin_groups_model.item(index, 0)->data(this->data_->kin_groups_model.NameRole).toString();
+    QString group_name = this->data_->kin_groups_model.getName(index);
     if (this->data_->kin_groups_model.removeRow(index))
     {
       // Remove Group States, TCPs and OPW Kinematics associated with the group
@@ -305,62 +323,57 @@ void TesseractSetupWizard::onRemoveKinematicGroup(int index)
   }
 }
 
-void TesseractSetupWizard::onGenerateACM(long resolution)
+void TesseractSetupWizard::onGenerateACM(long resolution, int sampling_mode, double confidence)
 {
   auto env = this->data_->render_util.getEnvironment();
-  auto manip_manager = this->data_->render_util.getEnvironment()->getManipulatorManager();
-  auto contact_manager = env->getDiscreteContactManager();
-  auto state_solver = env->getStateSolver();
 
-  // We want to disable the allowed contact function for this process so it is set null
-  contact_manager->setIsContactAllowedFn(nullptr);
-  tesseract_collision::ContactResultMap results;
-  tesseract_collision::ContactRequest request;
-  request.type = tesseract_collision::ContactTestType::ALL;
+  ACMGeneratorConfig config;
+  config.resolution = resolution;
+  config.confidence = confidence;
+  config.sampling_mode = (sampling_mode == static_cast<int>(ACMSamplingMode::HALTON)) ? ACMSamplingMode::HALTON :
+                                                                                         ACMSamplingMode::RANDOM;
 
-  for (long i = 0; i < resolution; ++i)
-  {
-    tesseract_environment::EnvState::Ptr state = state_solver->getRandomState();
-    contact_manager->setCollisionObjectsTransform(state->link_transforms);
-    contact_manager->contactTest(results, request);
-  }
+  // The pair statistics are cached per robot so only pairs whose links changed are sampled again
+  QDir cache_dir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/acm_cache");
+  QString cache_filepath = cache_dir.filePath(QString::fromStdString(env->getSceneGraph()->getName()) + ".txt");
+  ACMGeneratorCache cache;
+  cache.load(cache_filepath.toStdString());
 
-  this->data_->acm_model.clear();
-  for (const auto& pair : results)
-  {
-    double percent = double(pair.second.size()) / double(resolution);
-    if (percent > 0.95)
-    {
-      std::vector<std::string> adj_first = env->getSceneGraph()->getAdjacentLinkNames(pair.first.first);
-      std::vector<std::string> adj_second = env->getSceneGraph()->getAdjacentLinkNames(pair.first.second);
-      if (std::find(adj_first.begin(), adj_first.end(), pair.first.second) != adj_first.end())
-        env->addAllowedCollision(pair.first.first, pair.first.second, "Adjacent");
-      else if (std::find(adj_second.begin(), adj_second.end(), pair.first.first) != adj_second.end())
-        env->addAllowedCollision(pair.first.second, pair.first.first, "Adjacent");
-      else
-        env->addAllowedCollision(pair.first.second, pair.first.first, "Allways");
-    }
-  }
+  ACMContactCounts counts = sampleContacts(*env, config, &cache);
 
-  std::vector<std::string> link_names = env->getLinkNames();
-  for (std::size_t i = 0; i < link_names.size() - 1; ++i)
-  {
-    const auto& link1 = env->getLink(link_names[i]);
-    if (link1->collision.empty())
-      continue;
+  if (!cache_dir.mkpath(".") || !cache.save(cache_filepath.toStdString()))
+    ignwarn << "Failed to save the ACM generation cache: " << cache_filepath.toStdString() << std::endl;
 
+  // The generated matrix replaces the current one, only the changed pairs are sent to the environment
+  std::vector<AllowedCollisionMatrixModel::Entry> entries;
+  const std::vector<std::string>& link_names = counts.getLinkNames();
+  for (std::size_t i = 0; i + 1 < link_names.size(); ++i)
+  {
     for (std::size_t j = i + 1; j < link_names.size(); ++j)
     {
-      const auto& link2 = env->getLink(link_names[j]);
-      if (link2->collision.empty())
-        continue;
-
-      if (results.find(tesseract_collision::getObjectPairKey(link_names[i], link_names[j])) == results.end())
-        env->addAllowedCollision(link_names[i], link_names[j], "Never");
+      QString link1 = QString::fromStdString(link_names[i]);
+      QString link2 = QString::fromStdString(link_names[j]);
+      ACMPairClass pair_class = counts.getPairClass(counts.getPairIndex(i, j));
+      if (pair_class == ACMPairClass::NEVER)
+      {
+        entries.push_back({ link1, link2, "Never" });
+      }
+      else if (pair_class == ACMPairClass::ALWAYS)
+      {
+        // The adjacent links are the children of a link, so either link may be the parent
+        std::vector<std::string> adj_first = env->getSceneGraph()->getAdjacentLinkNames(link_names[i]);
+        std::vector<std::string> adj_second = env->getSceneGraph()->getAdjacentLinkNames(link_names[j]);
+        if (std::find(adj_first.begin(), adj_first.end(), link_names[j]) != adj_first.end())
+          entries.push_back({ link1, link2, "Adjacent" });
+        else if (std::find(adj_second.begin(), adj_second.end(), link_names[i]) != adj_second.end())
+          entries.push_back({ link2, link1, "Adjacent" });
+        else
+          entries.push_back({ link1, link2, "Allways" });
+      }
     }
   }
 
-  this->data_->acm_model.setEnvironment(this->data_->render_util.getEnvironment());
+  this->data_->acm_model.apply(std::move(entries));
 }
 
 void TesseractSetupWizard::onRemoveACMEntry(int index)
@@ -368,11 +381,20 @@ void TesseractSetupWizard::onRemoveACMEntry(int index)
   this->data_->acm_model.removeRow(index);
 }
 
-void TesseractSetupWizard::onClickedACMEntry(int /*index*/)
+void TesseractSetupWizard::onClickedACMEntry(int index)
+{
+  QModelIndex model_index = this->data_->acm_model.index(index, 0);
+  if (!model_index.isValid())
+    return;
+
+  std::string link1 = this->data_->acm_model.data(model_index, AllowedCollisionMatrixModel::Link1Role).toString().toStdString();
+  std::string link2 = this->data_->acm_model.data(model_index, AllowedCollisionMatrixModel::Link2Role).toString().toStdString();
+  this->data_->render_util.selectLinks({ link1, link2 });
+}
+
+void TesseractSetupWizard::onClickedLink(const QString &link_name)
 {
-//  this->data_->selected_entities.clear();
-//  this->data_->selected_entities.push_back(this->data_->entity_manager.getLink("link_1"));
-//  this->data_->update_selections = true;
+  this->data_->render_util.selectLinks({ link_name.toStdString() });
 }
 
 void TesseractSetupWizard::onLoadJointGroup(const QString &group_name)
@@ -384,18 +406,13 @@ void TesseractSetupWizard::onLoadJointGroup(const QString &group_name)
       this->data_->joint_group_model.add(this->data_->render_util.getEnvironmentConst()->getSceneGraph()->getJoint(joint_name));
 }
 
-void TesseractSetupWizard::onJointValue(const QString &joint_name, double joint_value)
+void TesseractSetupWizard::onJointValue(int index, double joint_value)
 {
-  for (int i = 0; i < this->data_->joint_group_model.rowCount(); ++i)
-  {
-    QStandardItem* item = this->data_->joint_group_model.item(i);
-    if (item->data(this->data_->joint_group_model.NameRole).toString() == joint_name)
-    {
-      item->setData(QString::number(joint_value), this->data_->joint_group_model.ValueRole);
-      break;
-    }
-  }
-  this->data_->render_util.setEnvironmentState({joint_name.toStdString()}, {joint_value});
+  if (!this->data_->joint_group_model.setValue(index, joint_value))
+    return;
+
+  std::string joint_name = this->data_->joint_group_model.getName(index).toStdString();
+  this->data_->render_util.queueEnvironmentState({ { joint_name, joint_value } });
 }
 
 void TesseractSetupWizard::onAddUserDefinedJointState(const QString &group_name, const QString &state_name)
@@ -419,6 +436,23 @@ void TesseractSetupWizard::onRemoveUserDefinedJointState(int index)
   this->data_->user_joint_states_model.removeRow(index);
 }
 
+void TesseractSetupWizard::onImportUserDefinedJointStates(const QString &filepath)
+{
+  QString local_filepath = toLocalFilePath(filepath);
+  int count = this->data_->user_joint_states_model.importCSV(local_filepath);
+  if (count < 0)
+    ignerr << "Failed to import user defined joint states: " << local_filepath.toStdString() << std::endl;
+  else
+    ignmsg << "Imported " << count << " user defined joint states from " << local_filepath.toStdString() << std::endl;
+}
+
+void TesseractSetupWizard::onExportUserDefinedJointStates(const QString &filepath)
+{
+  QString local_filepath = toLocalFilePath(filepath);
+  if (!this->data_->user_joint_states_model.exportCSV(local_filepath))
+    ignerr << "Failed to export user defined joint states: " << local_filepath.toStdString() << std::endl;
+}
+
 void TesseractSetupWizard::onAddUserDefinedTCP(const QString &group_name,
                                                const QString &tcp_name,
                                                const QVector3D& position,
@@ -434,6 +468,23 @@ void TesseractSetupWizard::onRemoveUserDefinedTCP(int index)
   this->data_->user_tcp_model.removeRow(index);
 }
 
+void TesseractSetupWizard::onImportUserDefinedTCPs(const QString &filepath)
+{
+  QString local_filepath = toLocalFilePath(filepath);
+  int count = this->data_->user_tcp_model.importCSV(local_filepath);
+  if (count < 0)
+    ignerr << "Failed to import user defined tool center points: " << local_filepath.toStdString() << std::endl;
+  else
+    ignmsg << "Imported " << count << " user defined tool center points from " << local_filepath.toStdString() << std::endl;
+}
+
+void TesseractSetupWizard::onExportUserDefinedTCPs(const QString &filepath)
+{
+  QString local_filepath = toLocalFilePath(filepath);
+  if (!this->data_->user_tcp_model.exportCSV(local_filepath))
+    ignerr << "Failed to export user defined tool center points: " << local_filepath.toStdString() << std::endl;
+}
+
 void TesseractSetupWizard::onAddGroupOPWKinematics(const QString& group_name,
                                                    double a1, double a2, double b,
                                                    double c1, double c2, double c3, double c4,
@@ -449,6 +500,12 @@ void TesseractSetupWizard::onRemoveGroupOPWKinematics(int index)
   this->data_->opw_kinematics_model.removeRow(index);
 }
 
+void TesseractSetupWizard::onFitGroupOPWKinematics(const QString& group_name)
+{
+  if (!group_name.trimmed().isEmpty())
+    this->data_->opw_kinematics_model.fit(group_name);
+}
+
 bool TesseractSetupWizard::eventFilter(QObject *_obj, QEvent *_event)
 {
   if (_event->type() == tesseract_ignition::gui::events::Render::Type)
@@ -459,6 +516,51 @@ bool TesseractSetupWizard::eventFilter(QObject *_obj, QEvent *_event)
       this->data_->render_util.init();
 
     this->data_->render_util.update();
+
+    // Let the other plugins know the scene was rebuilt for a new environment
+    if (this->data_->render_util.getSceneRevision() != this->data_->scene_revision)
+    {
+      this->data_->scene_revision = this->data_->render_util.getSceneRevision();
+      // The models read the scene graph in the Qt thread, so they get a copy like the entity manager
+      tesseract_scene_graph::SceneGraph::ConstPtr scene_graph =
+          this->data_->render_util.getEnvironmentConst()->getSceneGraph()->clone();
+      auto entity_manager = std::make_shared<const tesseract_visualization::EntityManager>(this->data_->render_util.getEntityManager());
+      ignition::gui::App()->sendEvent(ignition::gui::App()->findChild<ignition::gui::MainWindow *>(),
+                                      new tesseract_ignition::gui::events::SceneGraphLoaded(scene_graph, entity_manager));
+    }
+
+    // Let the other plugins know the selection changed, the event is not from the user so it is not sent back here
+    if (this->data_->render_util.getSelectionRevision() != this->data_->selection_revision)
+    {
+      this->data_->selection_revision = this->data_->render_util.getSelectionRevision();
+      std::vector<unsigned int> entities;
+      for (const auto& entity_id : this->data_->render_util.selectedEntities())
+        entities.push_back(static_cast<unsigned int>(entity_id));
+
+      auto main_window = ignition::gui::App()->findChild<ignition::gui::MainWindow *>();
+      if (entities.empty())
+        ignition::gui::App()->sendEvent(main_window, new tesseract_ignition::gui::events::DeselectAllEntities());
+      else
+        ignition::gui::App()->sendEvent(main_window, new tesseract_ignition::gui::events::EntitiesSelected(entities));
+    }
+  }
+  else if (_event->type() == tesseract_ignition::gui::events::EntitiesSelected::kType)
+  {
+    auto selected_event = static_cast<tesseract_ignition::gui::events::EntitiesSelected *>(_event);
+    if (selected_event->FromUser())
+    {
+      std::vector<tesseract_visualization::EntityID> entities;
+      for (const auto& entity : selected_event->Data())
+        entities.push_back(static_cast<tesseract_visualization::EntityID>(entity));
+
+      this->data_->render_util.selectEntities(entities);
+    }
+  }
+  else if (_event->type() == tesseract_ignition::gui::events::DeselectAllEntities::kType)
+  {
+    auto deselect_event = static_cast<tesseract_ignition::gui::events::DeselectAllEntities *>(_event);
+    if (deselect_event->FromUser())
+      this->data_->render_util.selectEntities({});
   }
 
   // Standard event processing
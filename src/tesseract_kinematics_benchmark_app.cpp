@@ -0,0 +1,130 @@
+/**
+ * @file tesseract_kinematics_benchmark_app.cpp
+ * @brief Benchmark the kinematic solvers of the groups defined in a URDF and SRDF
+ *
+ * @author Levi Armstrong
+ * @date October 18, 2026
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @copyright Copyright (c) 2020, Southwest Research Institute
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <ignition/common/Console.hh>
+#include <tesseract_environment/core/environment.h>
+#include <tesseract_environment/ofkt/ofkt_state_solver.h>
+#include <tesseract_scene_graph/resource_locator.h>
+#include <tesseract_ignition/kinematics_benchmark.h>
+#include <tesseract_ignition/utils.h>
+
+static void printUsage(const char* name)
+{
+  std::cout << "Usage: " << name << " <urdf> <srdf> [--group <name>] [--samples <count>] [--threads <count>]" << std::endl
+            << std::endl
+            << "Benchmark the forward and inverse kinematic solvers of every group defined in the SRDF, or only" << std::endl
+            << "the given group, over random reachable poses. The urdf and srdf may be file:// or package:// urls." << std::endl;
+}
+
+//////////////////////////////////////////////////
+int main(int _argc, char **_argv)
+{
+  if (_argc < 3)
+  {
+    printUsage(_argv[0]);
+    return 1;
+  }
+
+  std::string group_name;
+  tesseract_ignition::KinematicsBenchmarkConfig config;
+  for (int i = 3; i < _argc; ++i)
+  {
+    bool has_value = (i + 1 < _argc);
+    if (std::strcmp(_argv[i], "--group") == 0 && has_value)
+    {
+      group_name = _argv[++i];
+    }
+    else if (std::strcmp(_argv[i], "--samples") == 0 && has_value)
+    {
+      config.samples = std::atol(_argv[++i]);
+    }
+    else if (std::strcmp(_argv[i], "--threads") == 0 && has_value)
+    {
+      config.threads = static_cast<unsigned>(std::atoi(_argv[++i]));
+    }
+    else
+    {
+      printUsage(_argv[0]);
+      return 1;
+    }
+  }
+
+  auto locator = std::make_shared<tesseract_scene_graph::SimpleResourceLocator>(tesseract_ignition::locateResource);
+  auto urdf = locator->locateResource(_argv[1]);
+  auto srdf = locator->locateResource(_argv[2]);
+  if (urdf == nullptr || srdf == nullptr)
+  {
+    ignerr << "Failed to locate the URDF or SRDF!" << std::endl;
+    return 1;
+  }
+
+  auto env = std::make_shared<tesseract_environment::Environment>();
+  if (!env->init<tesseract_environment::OFKTStateSolver>(boost::filesystem::path(urdf->getFilePath()), boost::filesystem::path(srdf->getFilePath()), locator))
+  {
+    ignerr << "Failed to parse URDF/SRDF!" << std::endl;
+    return 1;
+  }
+
+  std::vector<std::string> group_names;
+  if (group_name.empty())
+    group_names = env->getManipulatorManager()->getAvailableFwdKinematicsManipulators();
+  else
+    group_names.push_back(group_name);
+
+  std::printf("%-20s %-28s %-3s %12s %12s %8s %10s %10s %10s %10s\n",
+              "group", "solver", "", "calls/s", "solutions/s", "success", "p50 (us)", "p90 (us)", "p99 (us)", "max (us)");
+
+  for (const auto& name : group_names)
+  {
+    std::vector<tesseract_ignition::KinematicsBenchmarkResult> results = tesseract_ignition::benchmarkKinematics(*env, name, config);
+    if (results.empty())
+    {
+      ignwarn << "Group " << name << " has no forward kinematics, skipping" << std::endl;
+      continue;
+    }
+
+    for (const auto& r : results)
+    {
+      std::printf("%-20s %-28s %-3s %12.0f %12.0f %7.1f%% %10.2f %10.2f %10.2f %10.2f\n",
+                  r.group_name.c_str(),
+                  r.solver_name.c_str(),
+                  r.inverse ? "IK" : "FK",
+                  r.getCallsPerSecond(),
+                  r.getSolutionsPerSecond(),
+                  100.0 * r.getSuccessRate(),
+                  r.latency_p50,
+                  r.latency_p90,
+                  r.latency_p99,
+                  r.latency_max);
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,208 @@
+/**
+ * @file scene_graph_search_index.cpp
+ * @brief A trigram index for searching the links, joints and visuals of a scene graph by scoped name
+ *
+ * @author Levi Armstrong
+ * @date October 18, 2026
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @copyright Copyright (c) 2020, Southwest Research Institute
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_ignition/tree/scene_graph_search_index.h>
+#include <algorithm>
+#include <cctype>
+#include <utility>
+
+namespace tesseract_ignition
+{
+
+static std::string toLower(const std::string& text)
+{
+  std::string lower(text);
+  std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+  return lower;
+}
+
+/** @brief Get the unique trigrams of a lower case string */
+static std::vector<std::uint32_t> getTrigrams(const std::string& text)
+{
+  std::vector<std::uint32_t> trigrams;
+  for (std::size_t i = 0; i + 3 <= text.size(); ++i)
+  {
+    trigrams.push_back((static_cast<std::uint32_t>(static_cast<unsigned char>(text[i])) << 16) |
+                       (static_cast<std::uint32_t>(static_cast<unsigned char>(text[i + 1])) << 8) |
+                       static_cast<std::uint32_t>(static_cast<unsigned char>(text[i + 2])));
+  }
+  std::sort(trigrams.begin(), trigrams.end());
+  trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+  return trigrams;
+}
+
+SceneGraphSearchIndex::SceneGraphSearchIndex(const tesseract_scene_graph::SceneGraph& scene_graph,
+                                             const tesseract_visualization::EntityManager& entity_manager)
+{
+  const auto& links = entity_manager.getLinks();
+  const auto& visuals = entity_manager.getVisuals();
+  if (scene_graph.getLink(scene_graph.getRoot()) == nullptr)
+    return;
+
+  // Walk the scene graph the way the tree shows it, a link is followed by its visuals and child joints
+  std::vector<std::pair<std::string, std::size_t>> stack { { scene_graph.getRoot(), 0 } };
+  while (!stack.empty())
+  {
+    std::string link_name = stack.back().first;
+    std::size_t parent = stack.back().second;
+    stack.pop_back();
+
+    SceneGraphSearchEntry link_entry;
+    link_entry.type = SceneGraphTreeNodeType::LINK;
+    link_entry.name = link_name;
+    link_entry.parent = parent;
+    auto link_it = links.find(link_name);
+    if (link_it != links.end())
+      link_entry.entity = link_it->second;
+    std::size_t link_index = addEntry(std::move(link_entry));
+
+    tesseract_scene_graph::Link::ConstPtr link = scene_graph.getLink(link_name);
+    if (link != nullptr)
+    {
+      for (std::size_t i = 1; i <= link->visual.size(); ++i)
+      {
+        auto visual_it = visuals.find(link_name + std::to_string(i));
+        if (visual_it == visuals.end())
+          continue;
+
+        SceneGraphSearchEntry visual_entry;
+        visual_entry.type = SceneGraphTreeNodeType::VISUAL;
+        visual_entry.name = visual_it->first;
+        visual_entry.parent = link_index;
+        visual_entry.entity = visual_it->second;
+        addEntry(std::move(visual_entry));
+      }
+    }
+
+    for (const auto& joint : scene_graph.getOutboundJoints(link_name))
+    {
+      SceneGraphSearchEntry joint_entry;
+      joint_entry.type = SceneGraphTreeNodeType::JOINT;
+      joint_entry.name = joint->getName();
+      joint_entry.parent = link_index;
+      stack.emplace_back(joint->child_link_name, addEntry(std::move(joint_entry)));
+    }
+  }
+}
+
+std::vector<SceneGraphSearchResult> SceneGraphSearchIndex::search(const std::string& query, std::size_t max_results) const
+{
+  std::vector<SceneGraphSearchResult> results;
+  std::string lower_query = toLower(query);
+  if (lower_query.empty() || max_results == 0)
+    return results;
+
+  // A name starting with the query ranks above one containing it, then shorter names rank first
+  auto getExactScore = [this, &lower_query](std::size_t entry) {
+    const std::string& key = keys_[entry];
+    bool prefix = (key.compare(0, lower_query.size(), lower_query) == 0);
+    return (prefix ? 3.0 : 2.0) + 1.0 / static_cast<double>(1 + key.size());
+  };
+
+  std::vector<std::uint32_t> query_trigrams = getTrigrams(lower_query);
+  if (query_trigrams.empty())
+  {
+    for (std::size_t i = 0; i < keys_.size(); ++i)
+    {
+      if (keys_[i].find(lower_query) != std::string::npos)
+        results.push_back({ i, true, getExactScore(i) });
+    }
+  }
+  else
+  {
+    // Count the query trigrams each entry contains
+    std::vector<std::uint32_t> counts(entries_.size(), 0);
+    for (std::uint32_t trigram : query_trigrams)
+    {
+      auto it = trigrams_.find(trigram);
+      if (it == trigrams_.end())
+        continue;
+
+      for (std::uint32_t entry : it->second)
+        ++counts[entry];
+    }
+
+    auto total = static_cast<double>(query_trigrams.size());
+    for (std::size_t i = 0; i < counts.size(); ++i)
+    {
+      if (counts[i] == 0)
+        continue;
+
+      // Only an entry with every trigram can contain the query
+      if (counts[i] == query_trigrams.size() && keys_[i].find(lower_query) != std::string::npos)
+        results.push_back({ i, true, getExactScore(i) });
+      else if (2 * counts[i] >= query_trigrams.size())
+        results.push_back({ i, false, static_cast<double>(counts[i]) / total });
+    }
+  }
+
+  auto by_score = [](const SceneGraphSearchResult& a, const SceneGraphSearchResult& b) {
+    return (a.score != b.score) ? (a.score > b.score) : (a.entry < b.entry);
+  };
+
+  if (results.size() > max_results)
+  {
+    std::partial_sort(results.begin(), results.begin() + static_cast<long>(max_results), results.end(), by_score);
+    results.resize(max_results);
+  }
+  else
+  {
+    std::sort(results.begin(), results.end(), by_score);
+  }
+
+  return results;
+}
+
+const SceneGraphSearchEntry& SceneGraphSearchIndex::getEntry(std::size_t index) const
+{
+  return entries_.at(index);
+}
+
+std::string SceneGraphSearchIndex::getScopedName(std::size_t index) const
+{
+  std::string scoped_name = entries_.at(index).name;
+  for (std::size_t i = index; i != entries_[i].parent; i = entries_[i].parent)
+    scoped_name = entries_[entries_[i].parent].name + "::" + scoped_name;
+
+  return scoped_name;
+}
+
+std::size_t SceneGraphSearchIndex::size() const
+{
+  return entries_.size();
+}
+
+std::size_t SceneGraphSearchIndex::addEntry(SceneGraphSearchEntry entry)
+{
+  auto index = static_cast<std::uint32_t>(entries_.size());
+  keys_.push_back(toLower(entry.name));
+  for (std::uint32_t trigram : getTrigrams(keys_.back()))
+    trigrams_[trigram].push_back(index);
+
+  entries_.push_back(std::move(entry));
+  return index;
+}
+
+}
@@ -0,0 +1,115 @@
+/**
+ * @file scene_graph_search_model.cpp
+ * @brief A Qt List Model of the links, joints and visuals of a scene graph matching a search query
+ *
+ * @author Levi Armstrong
+ * @date October 18, 2026
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @copyright Copyright (c) 2020, Southwest Research Institute
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_ignition/tree/scene_graph_search_model.h>
+
+namespace tesseract_ignition
+{
+
+SceneGraphSearchModel::SceneGraphSearchModel(QObject *parent)
+  : QAbstractListModel(parent)
+{
+}
+
+void SceneGraphSearchModel::setSceneGraph(tesseract_scene_graph::SceneGraph::ConstPtr scene_graph,
+                                          const tesseract_visualization::EntityManager& entity_manager)
+{
+  beginResetModel();
+  scene_graph_ = std::move(scene_graph);
+  entity_manager_ = std::make_unique<tesseract_visualization::EntityManager>(entity_manager);
+  index_ = nullptr;
+  results_.clear();
+  endResetModel();
+}
+
+void SceneGraphSearchModel::clear()
+{
+  beginResetModel();
+  scene_graph_ = nullptr;
+  entity_manager_ = nullptr;
+  index_ = nullptr;
+  results_.clear();
+  endResetModel();
+}
+
+void SceneGraphSearchModel::search(const QString& query)
+{
+  beginResetModel();
+  results_.clear();
+  if (!query.trimmed().isEmpty() && scene_graph_ != nullptr)
+  {
+    if (index_ == nullptr)
+      index_ = std::make_unique<SceneGraphSearchIndex>(*scene_graph_, *entity_manager_);
+
+    results_ = index_->search(query.trimmed().toStdString(), max_results_);
+  }
+  endResetModel();
+}
+
+int SceneGraphSearchModel::rowCount(const QModelIndex &parent) const
+{
+  if (parent.isValid())
+    return 0;
+
+  return static_cast<int>(results_.size());
+}
+
+QVariant SceneGraphSearchModel::data(const QModelIndex &index, int role) const
+{
+  if (!index.isValid() || index.row() < 0 || index.row() >= static_cast<int>(results_.size()))
+    return QVariant();
+
+  const SceneGraphSearchResult& result = results_[static_cast<std::size_t>(index.row())];
+  const SceneGraphSearchEntry& entry = index_->getEntry(result.entry);
+  switch (role)
+  {
+    case Qt::DisplayRole:
+    case NameRole:
+      return QString::fromStdString(entry.name);
+    case ScopedNameRole:
+      return QString::fromStdString(index_->getScopedName(result.entry));
+    case EntityRole:
+      return static_cast<unsigned>(entry.entity);
+    case TypeRole:
+      return toQString(entry.type);
+    case ExactRole:
+      return result.exact;
+  }
+  return QVariant();
+}
+
+QHash<int, QByteArray> SceneGraphSearchModel::roleNames() const
+{
+  static const QHash<int, QByteArray> roles = {
+    { NameRole, "name" },
+    { ScopedNameRole, "scopedName" },
+    { EntityRole, "entity" },
+    { TypeRole, "type" },
+    { ExactRole, "exact" }
+  };
+  return roles;
+}
+
+}
@@ -0,0 +1,498 @@
+/**
+ * @file scene_graph_tree_model.cpp
+ * @brief A Qt Tree Model of the links, joints and visuals of a scene graph
+ *
+ * @author Levi Armstrong
+ * @date October 18, 2026
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @copyright Copyright (c) 2020, Southwest Research Institute
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_ignition/tree/scene_graph_tree_model.h>
+#include <algorithm>
+#include <map>
+
+namespace tesseract_ignition
+{
+
+QString toQString(SceneGraphTreeNodeType type)
+{
+  switch (type)
+  {
+    case SceneGraphTreeNodeType::LINK:
+      return "link";
+    case SceneGraphTreeNodeType::JOINT:
+      return "joint";
+    case SceneGraphTreeNodeType::VISUAL:
+      return "visual";
+  }
+  return QString();
+}
+
+/** @brief Get the name of the child link of a joint node, whether or not it has been created */
+static std::string getChildLinkName(const SceneGraphTreeNode& joint_node)
+{
+  if (!joint_node.pending.empty())
+    return joint_node.pending.front().second;
+
+  if (!joint_node.children.empty())
+    return joint_node.children.front()->name;
+
+  return std::string();
+}
+
+SceneGraphTreeModel::SceneGraphTreeModel(QObject *parent)
+  : QAbstractItemModel(parent)
+{
+}
+
+void SceneGraphTreeModel::setSceneGraph(tesseract_scene_graph::SceneGraph::ConstPtr scene_graph,
+                                        const tesseract_visualization::EntityManager& entity_manager)
+{
+  beginResetModel();
+  scene_graph_ = std::move(scene_graph);
+  link_entities_.clear();
+  visual_entities_.clear();
+  joint_nodes_.clear();
+  entity_nodes_.clear();
+  entity_links_.clear();
+  root_ = nullptr;
+
+  if (scene_graph_ != nullptr)
+  {
+    link_entities_.insert(entity_manager.getLinks().begin(), entity_manager.getLinks().end());
+    visual_entities_.insert(entity_manager.getVisuals().begin(), entity_manager.getVisuals().end());
+    if (scene_graph_->getLink(scene_graph_->getRoot()) != nullptr)
+    {
+      root_ = createNode(SceneGraphTreeNodeType::LINK, scene_graph_->getRoot());
+      addToIndex(root_.get());
+    }
+  }
+  endResetModel();
+}
+
+void SceneGraphTreeModel::clear()
+{
+  beginResetModel();
+  root_ = nullptr;
+  scene_graph_ = nullptr;
+  link_entities_.clear();
+  visual_entities_.clear();
+  joint_nodes_.clear();
+  entity_nodes_.clear();
+  entity_links_.clear();
+  endResetModel();
+}
+
+void SceneGraphTreeModel::removeLinks(const std::vector<std::string>& link_names)
+{
+  if (root_ == nullptr)
+    return;
+
+  entity_links_.clear();
+
+  // The node removed for a link is the joint above it, whose only child is the link
+  std::unordered_set<SceneGraphTreeNode*> targets;
+  for (const auto& link_name : link_names)
+  {
+    if (link_name == root_->name)
+    {
+      clear();
+      return;
+    }
+
+    auto it = joint_nodes_.find(link_name);
+    if (it != joint_nodes_.end())
+      targets.insert(it->second);
+  }
+
+  // Drop the targets below another target and group the rest by parent with their rows in order
+  std::map<SceneGraphTreeNode*, std::vector<int>> removals;
+  for (SceneGraphTreeNode* target : targets)
+  {
+    bool nested = false;
+    for (SceneGraphTreeNode* node = target->parent; node != nullptr && !nested; node = node->parent)
+      nested = (targets.find(node) != targets.end());
+
+    if (!nested)
+      removals[target->parent].push_back(target->row);
+  }
+
+  for (auto& removal : removals)
+  {
+    SceneGraphTreeNode* parent = removal.first;
+    std::vector<int>& rows = removal.second;
+    std::sort(rows.begin(), rows.end());
+
+    // Remove the contiguous ranges from the last so the rows of the earlier ones stay valid
+    std::size_t end = rows.size();
+    while (end > 0)
+    {
+      std::size_t begin = end - 1;
+      while (begin > 0 && rows[begin - 1] == rows[begin] - 1)
+        --begin;
+
+      removeChildren(parent, rows[begin], rows[end - 1]);
+      end = begin;
+    }
+  }
+}
+
+QString SceneGraphTreeModel::scopedName(const QModelIndex &index) const
+{
+  QString scoped_name;
+  for (const SceneGraphTreeNode* node = getNode(index); node != nullptr; node = node->parent)
+  {
+    QString name = QString::fromStdString(node->name);
+    scoped_name = scoped_name.isEmpty() ? name : name + "::" + scoped_name;
+  }
+  return scoped_name;
+}
+
+unsigned SceneGraphTreeModel::entity(const QModelIndex &index) const
+{
+  const SceneGraphTreeNode* node = getNode(index);
+  return (node != nullptr) ? static_cast<unsigned>(node->entity) : 0;
+}
+
+QModelIndex SceneGraphTreeModel::entityIndex(unsigned entity) const
+{
+  auto it = entity_nodes_.find(static_cast<tesseract_visualization::EntityID>(entity));
+  return (it != entity_nodes_.end()) ? getIndex(it->second) : QModelIndex();
+}
+
+QModelIndex SceneGraphTreeModel::fetchEntityIndex(unsigned entity)
+{
+  auto id = static_cast<tesseract_visualization::EntityID>(entity);
+  auto node_it = entity_nodes_.find(id);
+  if (node_it != entity_nodes_.end())
+    return getIndex(node_it->second);
+
+  if (root_ == nullptr)
+    return QModelIndex();
+
+  if (entity_links_.empty())
+  {
+    for (const auto& link_entity : link_entities_)
+    {
+      entity_links_[link_entity.second] = link_entity.first;
+      tesseract_scene_graph::Link::ConstPtr link = scene_graph_->getLink(link_entity.first);
+      if (link == nullptr)
+        continue;
+
+      for (std::size_t i = 1; i <= link->visual.size(); ++i)
+      {
+        auto visual_it = visual_entities_.find(link_entity.first + std::to_string(i));
+        if (visual_it != visual_entities_.end())
+          entity_links_[visual_it->second] = link_entity.first;
+      }
+    }
+  }
+
+  auto link_it = entity_links_.find(id);
+  if (link_it == entity_links_.end())
+    return QModelIndex();
+
+  // Collect the links from the entity's link up to the root
+  std::vector<std::string> path;
+  for (std::string link_name = link_it->second; link_name != root_->name;)
+  {
+    path.push_back(link_name);
+    std::vector<tesseract_scene_graph::Joint::ConstPtr> joints = scene_graph_->getInboundJoints(link_name);
+    if (joints.empty())
+      return QModelIndex();
+
+    link_name = joints.front()->parent_link_name;
+  }
+
+  // Fetch each link and the joint below it down to the entity's link
+  SceneGraphTreeNode* node = root_.get();
+  for (auto it = path.rbegin(); it != path.rend(); ++it)
+  {
+    fetchMore(getIndex(node));
+    auto joint_it = joint_nodes_.find(*it);
+    if (joint_it == joint_nodes_.end())
+      return QModelIndex();
+
+    SceneGraphTreeNode* joint_node = joint_it->second;
+    fetchMore(getIndex(joint_node));
+    if (joint_node->children.empty())
+      return QModelIndex();
+
+    node = joint_node->children.front().get();
+  }
+
+  // A visual is a child of the link
+  if (node->entity != id)
+    fetchMore(getIndex(node));
+
+  return entityIndex(entity);
+}
+
+QModelIndex SceneGraphTreeModel::index(int row, int column, const QModelIndex &parent) const
+{
+  if (column != 0 || row < 0)
+    return QModelIndex();
+
+  if (!parent.isValid())
+    return (root_ != nullptr && row == 0) ? createIndex(0, 0, root_.get()) : QModelIndex();
+
+  SceneGraphTreeNode* node = getNode(parent);
+  if (node == nullptr || row >= static_cast<int>(node->children.size()))
+    return QModelIndex();
+
+  return createIndex(row, 0, node->children[static_cast<std::size_t>(row)].get());
+}
+
+QModelIndex SceneGraphTreeModel::parent(const QModelIndex &index) const
+{
+  SceneGraphTreeNode* node = getNode(index);
+  if (node == nullptr || node->parent == nullptr)
+    return QModelIndex();
+
+  return createIndex(node->parent->row, 0, node->parent);
+}
+
+int SceneGraphTreeModel::rowCount(const QModelIndex &parent) const
+{
+  if (!parent.isValid())
+    return (root_ != nullptr) ? 1 : 0;
+
+  SceneGraphTreeNode* node = getNode(parent);
+  return (node != nullptr) ? static_cast<int>(node->children.size()) : 0;
+}
+
+int SceneGraphTreeModel::columnCount(const QModelIndex &/*parent*/) const
+{
+  return 1;
+}
+
+bool SceneGraphTreeModel::hasChildren(const QModelIndex &parent) const
+{
+  if (!parent.isValid())
+    return (root_ != nullptr);
+
+  SceneGraphTreeNode* node = getNode(parent);
+  return (node != nullptr) && (!node->children.empty() || !node->pending.empty());
+}
+
+bool SceneGraphTreeModel::canFetchMore(const QModelIndex &parent) const
+{
+  SceneGraphTreeNode* node = getNode(parent);
+  return (node != nullptr) && !node->pending.empty();
+}
+
+void SceneGraphTreeModel::fetchMore(const QModelIndex &parent)
+{
+  SceneGraphTreeNode* node = getNode(parent);
+  if (node == nullptr || node->pending.empty())
+    return;
+
+  // Build the whole branch before telling the views so they only update once
+  std::vector<std::unique_ptr<SceneGraphTreeNode>> children;
+  children.reserve(node->pending.size());
+  int row = static_cast<int>(node->children.size());
+  for (const auto& child : node->pending)
+  {
+    // Skip the children removed from the scene graph since the node was created
+    if (!exists(child.first, child.second))
+      continue;
+
+    auto child_node = createNode(child.first, child.second);
+    child_node->parent = node;
+    child_node->row = row++;
+    children.push_back(std::move(child_node));
+  }
+  if (children.empty())
+  {
+    // A joint whose child link is gone has nothing left to be found by
+    if (node->type == SceneGraphTreeNodeType::JOINT)
+      joint_nodes_.erase(getChildLinkName(*node));
+
+    node->pending.clear();
+    return;
+  }
+
+  node->pending.clear();
+  node->pending.shrink_to_fit();
+
+  int first = static_cast<int>(node->children.size());
+  beginInsertRows(parent, first, first + static_cast<int>(children.size()) - 1);
+  node->children.reserve(node->children.size() + children.size());
+  for (auto& child : children)
+  {
+    addToIndex(child.get());
+    node->children.push_back(std::move(child));
+  }
+  endInsertRows();
+}
+
+QVariant SceneGraphTreeModel::data(const QModelIndex &index, int role) const
+{
+  SceneGraphTreeNode* node = getNode(index);
+  if (node == nullptr)
+    return QVariant();
+
+  switch (role)
+  {
+    case Qt::DisplayRole:
+    case NameRole:
+      return QString::fromStdString(node->name);
+    case EntityRole:
+      return static_cast<unsigned>(node->entity);
+    case TypeRole:
+      return toQString(node->type);
+  }
+  return QVariant();
+}
+
+QHash<int, QByteArray> SceneGraphTreeModel::roleNames() const
+{
+  static const QHash<int, QByteArray> roles = {
+    { NameRole, "name" },
+    { EntityRole, "entity" },
+    { TypeRole, "type" }
+  };
+  return roles;
+}
+
+std::unique_ptr<SceneGraphTreeNode> SceneGraphTreeModel::createNode(SceneGraphTreeNodeType type, const std::string& name) const
+{
+  auto node = std::make_unique<SceneGraphTreeNode>();
+  node->type = type;
+  node->name = name;
+
+  switch (type)
+  {
+    case SceneGraphTreeNodeType::LINK:
+    {
+      auto it = link_entities_.find(name);
+      if (it != link_entities_.end())
+        node->entity = it->second;
+
+      // Visuals are named by toScene after the link and their one based position
+      tesseract_scene_graph::Link::ConstPtr link = scene_graph_->getLink(name);
+      if (link != nullptr)
+      {
+        for (std::size_t i = 1; i <= link->visual.size(); ++i)
+        {
+          std::string visual_name = name + std::to_string(i);
+          if (visual_entities_.find(visual_name) != visual_entities_.end())
+            node->pending.emplace_back(SceneGraphTreeNodeType::VISUAL, visual_name);
+        }
+      }
+
+      for (const auto& joint : scene_graph_->getOutboundJoints(name))
+        node->pending.emplace_back(SceneGraphTreeNodeType::JOINT, joint->getName());
+
+      break;
+    }
+    case SceneGraphTreeNodeType::JOINT:
+    {
+      tesseract_scene_graph::Joint::ConstPtr joint = scene_graph_->getJoint(name);
+      if (joint != nullptr)
+        node->pending.emplace_back(SceneGraphTreeNodeType::LINK, joint->child_link_name);
+
+      break;
+    }
+    case SceneGraphTreeNodeType::VISUAL:
+    {
+      auto it = visual_entities_.find(name);
+      if (it != visual_entities_.end())
+        node->entity = it->second;
+
+      break;
+    }
+  }
+
+  return node;
+}
+
+bool SceneGraphTreeModel::exists(SceneGraphTreeNodeType type, const std::string& name) const
+{
+  switch (type)
+  {
+    case SceneGraphTreeNodeType::LINK:
+      return (scene_graph_->getLink(name) != nullptr);
+    case SceneGraphTreeNodeType::JOINT:
+      return (scene_graph_->getJoint(name) != nullptr);
+    case SceneGraphTreeNodeType::VISUAL:
+      return true;
+  }
+  return false;
+}
+
+void SceneGraphTreeModel::addToIndex(SceneGraphTreeNode* node)
+{
+  if (node->type == SceneGraphTreeNodeType::JOINT)
+    joint_nodes_[getChildLinkName(*node)] = node;
+
+  if (node->entity != 0)
+    entity_nodes_[node->entity] = node;
+}
+
+void SceneGraphTreeModel::removeFromIndex(const SceneGraphTreeNode* node)
+{
+  std::vector<const SceneGraphTreeNode*> stack { node };
+  while (!stack.empty())
+  {
+    const SceneGraphTreeNode* current = stack.back();
+    stack.pop_back();
+
+    if (current->type == SceneGraphTreeNodeType::JOINT)
+      joint_nodes_.erase(getChildLinkName(*current));
+
+    if (current->entity != 0)
+      entity_nodes_.erase(current->entity);
+
+    for (const auto& child : current->children)
+      stack.push_back(child.get());
+  }
+}
+
+void SceneGraphTreeModel::removeChildren(SceneGraphTreeNode* node, int first, int last)
+{
+  beginRemoveRows(getIndex(node), first, last);
+  auto begin = node->children.begin() + first;
+  auto end = node->children.begin() + last + 1;
+  for (auto it = begin; it != end; ++it)
+    removeFromIndex(it->get());
+
+  node->children.erase(begin, end);
+
+  // The views use the rows of the following children while handling the removal
+  for (auto row = static_cast<std::size_t>(first); row < node->children.size(); ++row)
+    node->children[row]->row = static_cast<int>(row);
+
+  endRemoveRows();
+}
+
+SceneGraphTreeNode* SceneGraphTreeModel::getNode(const QModelIndex &index) const
+{
+  if (!index.isValid() || index.model() != this)
+    return nullptr;
+
+  return static_cast<SceneGraphTreeNode*>(index.internalPointer());
+}
+
+QModelIndex SceneGraphTreeModel::getIndex(SceneGraphTreeNode* node) const
+{
+  return (node != nullptr) ? createIndex(node->row, 0, node) : QModelIndex();
+}
+
+}
@@ -1,16 +1,49 @@
 #include <tesseract_ignition/utils.h>
+#include <tesseract_ignition/package_resolver.h>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <unordered_map>
-#include <boost/algorithm/string/classification.hpp>
-#include <boost/algorithm/string/split.hpp>
 #include <ignition/common/Console.hh>
-#include <QDir>
-
-static std::unordered_map<std::string, std::string> cache_package_paths;
 
 namespace tesseract_ignition
 {
 
-std::string locateResource(const std::string& url)
+/** @brief The resolved urls, they are only valid for the search paths they were resolved with */
+struct ResourceCache
+{
+  std::shared_mutex mutex;
+
+  /** @brief The values of TSW_RESOURCE_PATH and ROS_PACKAGE_PATH the resolver was created with */
+  std::string tsw_resource_path;
+  std::string ros_package_path;
+
+  std::shared_ptr<const PackageResolver> resolver;
+
+  /** @brief The result of each url, empty if it could not be resolved */
+  std::unordered_map<std::string, std::string> urls;
+};
+
+static ResourceCache& getResourceCache()
+{
+  static ResourceCache cache;
+  return cache;
+}
+
+/** @brief Check if an environment variable still has the value the cache was created with */
+static bool isUnchanged(const char* value, const std::string& cached)
+{
+  return (value == nullptr) ? cached.empty() : (cached == value);
+}
+
+/**
+ * @brief Resolve a url without the cache
+ * @param message Set to the problem to log, if any
+ * @return The local file path, empty if it could not be resolved
+ */
+static std::string resolveResource(const std::string& url, const PackageResolver& resolver, std::string& message)
 {
   std::string mod_url = url;
   if (url.find("file:///") == 0)
@@ -34,67 +67,89 @@ std::string locateResource(const std::string& url)
     std::string package = mod_url.substr(0, pos);
     mod_url.erase(0, pos);
 
-    if (cache_package_paths.empty())
-    {
-      // This was added to allow user defined resource path
-      // When using this within a snap you can map host ros package paths to this environment variable
-      char* tsw_resource_paths = std::getenv("TSW_RESOURCE_PATH");
-      if (tsw_resource_paths != nullptr)
-      {
-        std::vector<std::string> tokens;
-        boost::split(tokens, tsw_resource_paths, boost::is_any_of(":"), boost::token_compress_on);
-        for (const auto& token : tokens)
-        {
-          QDir d(QString::fromStdString(token));
-          if (d.exists())
-          {
-            if (cache_package_paths.find(d.dirName().toStdString()) == cache_package_paths.end())
-              cache_package_paths[d.dirName().toStdString()] = token;
-          }
-          else
-          {
-            ignwarn << "ROS Package Path does not exist: " << token << std::endl;
-          }
-        }
-      }
-
-      char* ros_package_paths = std::getenv("ROS_PACKAGE_PATH");
-      if (ros_package_paths != nullptr)
-      {
-        std::vector<std::string> tokens;
-        boost::split(tokens, ros_package_paths, boost::is_any_of(":"), boost::token_compress_on);
-        for (const auto& token : tokens)
-        {
-          QDir d(QString::fromStdString(token));
-          if (d.exists())
-          {
-            if (cache_package_paths.find(d.dirName().toStdString()) == cache_package_paths.end())
-              cache_package_paths[d.dirName().toStdString()] = token;
-          }
-          else
-          {
-            ignwarn << "ROS Package Path does not exist: " << token << std::endl;
-          }
-        }
-      }
-    }
-    auto find_package = cache_package_paths.find(package);
-
-    if (find_package != cache_package_paths.end())
+    std::string package_path = resolver.findPackage(package);
+    if (!package_path.empty())
     {
-      mod_url = find_package->second + mod_url;
+      mod_url = package_path + mod_url;
     }
     else
     {
-      ignerr << "Failed to find package resource " << package << " for " << url << std::endl;
+      message = "Failed to find package resource " + package + " for " + url;
       return std::string();
     }
   }
   else
   {
-    ignwarn << "Resource not handled: " << mod_url << std::endl;
+    message = "Resource not handled: " + mod_url;
   }
 
   return mod_url;
 }
+
+std::string locateResource(const std::string& url)
+{
+  ResourceCache& cache = getResourceCache();
+  const char* tsw_resource_path = std::getenv("TSW_RESOURCE_PATH");
+  const char* ros_package_path = std::getenv("ROS_PACKAGE_PATH");
+
+  std::shared_ptr<const PackageResolver> resolver;
+  {
+    std::shared_lock<std::shared_mutex> lock(cache.mutex);
+    if (cache.resolver != nullptr && isUnchanged(tsw_resource_path, cache.tsw_resource_path) &&
+        isUnchanged(ros_package_path, cache.ros_package_path))
+    {
+      auto it = cache.urls.find(url);
+      if (it != cache.urls.end())
+        return it->second;
+
+      resolver = cache.resolver;
+    }
+  }
+
+  // The search paths changed, so the packages are crawled again and the urls resolved again
+  if (resolver == nullptr)
+  {
+    std::unique_lock<std::shared_mutex> lock(cache.mutex);
+    if (cache.resolver == nullptr || !isUnchanged(tsw_resource_path, cache.tsw_resource_path) ||
+        !isUnchanged(ros_package_path, cache.ros_package_path))
+    {
+      cache.tsw_resource_path = (tsw_resource_path == nullptr) ? "" : tsw_resource_path;
+      cache.ros_package_path = (ros_package_path == nullptr) ? "" : ros_package_path;
+      cache.resolver = std::make_shared<PackageResolver>(PackageResolver::getEnvironmentSearchPaths());
+      cache.urls.clear();
+    }
+    resolver = cache.resolver;
+  }
+
+  // Resolved without the lock, the first crawl of the packages can take a while
+  std::string message;
+  std::string mod_url = resolveResource(url, *resolver, message);
+
+  bool inserted = false;
+  {
+    std::unique_lock<std::shared_mutex> lock(cache.mutex);
+    if (cache.resolver == resolver)
+      inserted = cache.urls.emplace(url, mod_url).second;
+  }
+
+  // Only the thread that cached the url logs its problem, so each one is logged once
+  if (inserted && !message.empty())
+  {
+    if (mod_url.empty())
+      ignerr << message << std::endl;
+    else
+      ignwarn << message << std::endl;
+  }
+
+  return mod_url;
+}
+
+void clearResourceCache()
+{
+  ResourceCache& cache = getResourceCache();
+  std::unique_lock<std::shared_mutex> lock(cache.mutex);
+  cache.resolver = nullptr;
+  cache.urls.clear();
+}
+
 }